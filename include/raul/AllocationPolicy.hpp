@@ -0,0 +1,226 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_ALLOCATIONPOLICY_HPP
+#define RAUL_ALLOCATIONPOLICY_HPP
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace raul {
+
+/**
+   How memory for a real-time buffer is allocated.
+
+   Memory from the standard allocator is only backed by physical pages when
+   it is first touched, which often happens in the audio thread and causes
+   page faults (and so xruns) shortly after buffers are created.  The other
+   policies allocate pages directly from the system and touch every page
+   up front, so the first cycle is as fast as any other.
+
+   @ingroup raul
+*/
+enum class AllocationPolicy {
+  /// Use the standard allocator (new[] and delete[])
+  standard,
+
+  /// Lock in physical memory and touch every page when allocated
+  locked,
+
+  /// Like locked, but also use huge pages if possible (for large buffers)
+  huge,
+};
+
+/**
+   Allocate `size` bytes of zeroed memory with a non-standard policy.
+
+   The memory is locked with mlock() or VirtualLock() if possible.  Locking
+   is best-effort since it's often limited (see RLIMIT_MEMLOCK), but every
+   page is touched regardless, so memory is at least resident until the
+   system is under enough pressure to swap it out.
+
+   @return Memory which must be freed with free_memory().
+   @throw std::bad_alloc if the memory can't be allocated.
+*/
+inline void*
+allocate_memory(size_t size, AllocationPolicy policy);
+
+/// Free memory allocated by allocate_memory() with the same size and policy
+inline void
+free_memory(void* ptr, size_t size, AllocationPolicy policy);
+
+/**
+   Deleter for an array allocated by allocate_array().
+
+   This destroys the elements, then frees the memory according to the policy
+   it was allocated with.
+*/
+template<class T>
+struct ArrayDeleter {
+  void operator()(T* ptr) const
+  {
+    if (policy == AllocationPolicy::standard) {
+      delete[] ptr;
+    } else {
+      std::destroy_n(ptr, count);
+      free_memory(ptr, count * sizeof(T), policy);
+    }
+  }
+
+  size_t           count{0U};                          ///< Number of elements
+  AllocationPolicy policy{AllocationPolicy::standard}; ///< Allocation policy
+};
+
+/// An owning pointer to an array allocated by allocate_array()
+template<class T>
+using ArrayPtr = std::unique_ptr<T[], ArrayDeleter<T>>;
+
+/**
+   Allocate an array of `count` default-initialized elements.
+
+   @throw std::bad_alloc if the memory can't be allocated.
+*/
+template<class T>
+ArrayPtr<T>
+allocate_array(size_t count, AllocationPolicy policy)
+{
+  if (policy == AllocationPolicy::standard) {
+    return ArrayPtr<T>{new T[count], ArrayDeleter<T>{count, policy}};
+  }
+
+  void* const mem   = allocate_memory(count * sizeof(T), policy);
+  T* const    elems = static_cast<T*>(mem);
+  try {
+    std::uninitialized_default_construct_n(elems, count);
+  } catch (...) {
+    free_memory(mem, count * sizeof(T), policy);
+    throw;
+  }
+
+  return ArrayPtr<T>{elems, ArrayDeleter<T>{count, policy}};
+}
+
+namespace detail {
+
+/// Return the size actually mapped for a request of `size` bytes
+inline size_t
+mapped_size(size_t size, AllocationPolicy policy)
+{
+#ifdef _WIN32
+  SYSTEM_INFO info{};
+  GetSystemInfo(&info);
+  size_t page_size = info.dwPageSize;
+  if (policy == AllocationPolicy::huge && GetLargePageMinimum()) {
+    page_size = GetLargePageMinimum();
+  }
+#else
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  if (policy == AllocationPolicy::huge) {
+    page_size = size_t{2U} << 20U; // Common huge page size
+  }
+#endif
+
+  const size_t n_pages = (std::max(size, size_t{1U}) + page_size - 1U) /
+                         page_size;
+
+  return n_pages * page_size;
+}
+
+} // namespace detail
+
+#ifdef _WIN32
+
+inline void*
+allocate_memory(size_t size, AllocationPolicy policy)
+{
+  const size_t map_size = detail::mapped_size(size, policy);
+  const DWORD  type     = MEM_RESERVE | MEM_COMMIT;
+
+  void* mem = nullptr;
+  if (policy == AllocationPolicy::huge && GetLargePageMinimum()) {
+    // Requires SeLockMemoryPrivilege, so often fails
+    mem = VirtualAlloc(
+      nullptr, map_size, type | MEM_LARGE_PAGES, PAGE_READWRITE);
+  }
+
+  if (!mem) {
+    mem = VirtualAlloc(nullptr, map_size, type, PAGE_READWRITE);
+    if (!mem) {
+      throw std::bad_alloc{};
+    }
+  }
+
+  VirtualLock(mem, map_size);
+  memset(mem, 0, map_size);
+  return mem;
+}
+
+inline void
+free_memory(void* const ptr, size_t, AllocationPolicy)
+{
+  VirtualFree(ptr, 0U, MEM_RELEASE);
+}
+
+#else
+
+inline void*
+allocate_memory(size_t size, AllocationPolicy policy)
+{
+  const size_t map_size = detail::mapped_size(size, policy);
+  const int    prot     = PROT_READ | PROT_WRITE;
+  const int    flags    = MAP_PRIVATE | MAP_ANONYMOUS;
+
+  void* mem = MAP_FAILED;
+#  ifdef MAP_HUGETLB
+  if (policy == AllocationPolicy::huge) {
+    // Requires reserved huge pages, so often fails
+    mem = mmap(nullptr, map_size, prot, flags | MAP_HUGETLB, -1, 0);
+  }
+#  endif
+
+  if (mem == MAP_FAILED) {
+    mem = mmap(nullptr, map_size, prot, flags, -1, 0);
+    if (mem == MAP_FAILED) {
+      throw std::bad_alloc{};
+    }
+
+#  ifdef MADV_HUGEPAGE
+    if (policy == AllocationPolicy::huge) {
+      // Fall back to transparent huge pages
+      madvise(mem, map_size, MADV_HUGEPAGE);
+    }
+#  endif
+  }
+
+  mlock(mem, map_size);
+  memset(mem, 0, map_size);
+  return mem;
+}
+
+inline void
+free_memory(void* const ptr, size_t size, AllocationPolicy policy)
+{
+  const size_t map_size = detail::mapped_size(size, policy);
+
+  munlock(ptr, map_size);
+  munmap(ptr, map_size);
+}
+
+#endif
+
+} // namespace raul
+
+#endif // RAUL_ALLOCATIONPOLICY_HPP
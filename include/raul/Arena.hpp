@@ -0,0 +1,197 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_ARENA_HPP
+#define RAUL_ARENA_HPP
+
+#include <raul/AllocationPolicy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace raul {
+
+/**
+   A preallocated pool of fixed-size memory blocks.
+
+   All memory is allocated when the arena is created, and blocks are taken
+   from and returned to a lock-free free list, so both allocate() and
+   deallocate() are real-time safe, and may be called from any thread.
+
+   This allows real-time code to create short-lived objects.  Classes that
+   inherit from Arena::Allocated can be created in an arena with `new
+   (arena) T(...)`, or as a managed pointer with Maid::make_managed_in(),
+   and when such an object is deleted (for example by Maid::cleanup()), its
+   block is returned to the arena.
+
+   The arena must outlive every block allocated from it.
+
+   @ingroup raul
+*/
+class Arena
+{
+public:
+  /**
+     Mixin for classes that are allocated in an arena.
+
+     Objects must be created with `new (arena) T(...)`, which returns null if
+     the arena is exhausted or its blocks are too small.  A small header
+     before the object records which arena it came from, so that deleting
+     it returns the block to the right arena.
+  */
+  class Allocated
+  {
+  public:
+    /// Objects may only be allocated in an arena
+    static void* operator new(size_t size) = delete;
+
+    /// Allocate from an arena, or return null on failure
+    static void* operator new(size_t size, Arena& arena) noexcept
+    {
+      if (header_size + size > arena.block_size()) {
+        return nullptr;
+      }
+
+      void* const mem = arena.allocate();
+      if (!mem) {
+        return nullptr;
+      }
+
+      *static_cast<Arena**>(mem) = &arena;
+      return static_cast<std::byte*>(mem) + header_size;
+    }
+
+    /// Return the block of a deleted object to its arena
+    static void operator delete(void* ptr)
+    {
+      if (ptr) {
+        void* const mem = static_cast<std::byte*>(ptr) - header_size;
+        (*static_cast<Arena**>(mem))->deallocate(mem);
+      }
+    }
+
+    /// Free an object whose constructor threw when allocated in an arena
+    static void operator delete(void* ptr, Arena&) { operator delete(ptr); }
+
+  protected:
+    Allocated() = default;
+
+  private:
+    /// Size of the header, which keeps the object aligned
+    static constexpr size_t header_size = alignof(std::max_align_t);
+  };
+
+  /**
+     Create a new arena.
+
+     @param block_size Size of each block in bytes (note this may be rounded
+     up).  Objects allocated with Allocated need an extra
+     `alignof(std::max_align_t)` bytes for a header.
+
+     @param n_blocks Number of blocks.
+
+     @param policy Allocation policy for the memory.
+
+     @throw std::bad_alloc if memory can't be allocated.
+  */
+  Arena(size_t           block_size,
+        uint32_t         n_blocks,
+        AllocationPolicy policy = AllocationPolicy::standard)
+    : _block_size{round_up(block_size)}
+    , _n_blocks{n_blocks}
+    , _memory{allocate_array<std::byte>(_block_size * n_blocks, policy)}
+    , _next{new std::atomic<uint32_t>[n_blocks]}
+    , _head{0U}
+  {
+    for (uint32_t i = 0U; i < n_blocks; ++i) {
+      _next[i].store(i + 1U, std::memory_order_relaxed);
+    }
+  }
+
+  Arena(const Arena&)            = delete;
+  Arena& operator=(const Arena&) = delete;
+  Arena(Arena&&)                 = delete;
+  Arena& operator=(Arena&&)      = delete;
+
+  ~Arena() = default;
+
+  /// Return the size of each block in bytes
+  [[nodiscard]] size_t block_size() const { return _block_size; }
+
+  /// Return the total number of blocks
+  [[nodiscard]] uint32_t n_blocks() const { return _n_blocks; }
+
+  /**
+     Allocate a block.
+
+     @return A block aligned for any standard type, or null if all blocks
+     are in use.
+  */
+  void* allocate() noexcept
+  {
+    uint64_t head = _head.load(std::memory_order_acquire);
+    for (;;) {
+      const auto index = static_cast<uint32_t>(head);
+      if (index == _n_blocks) {
+        return nullptr;
+      }
+
+      // The tag is incremented on every change, so a stale next is detected
+      const uint32_t next = _next[index].load(std::memory_order_relaxed);
+      if (_head.compare_exchange_weak(head,
+                                      retag(head, next),
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire)) {
+        return &_memory[size_t{index} * _block_size];
+      }
+    }
+  }
+
+  /// Return a block from allocate() to the arena
+  void deallocate(void* ptr) noexcept
+  {
+    const auto index = static_cast<uint32_t>(
+      (static_cast<std::byte*>(ptr) - _memory.get()) /
+      static_cast<ptrdiff_t>(_block_size));
+
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    do {
+      _next[index].store(static_cast<uint32_t>(head),
+                         std::memory_order_relaxed);
+    } while (!_head.compare_exchange_weak(head,
+                                          retag(head, index),
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+  }
+
+private:
+  /// Round a block size up to keep every block aligned
+  static size_t round_up(size_t size)
+  {
+    constexpr size_t align = alignof(std::max_align_t);
+
+    return ((std::max(size, size_t{1U}) + align - 1U) / align) * align;
+  }
+
+  /// Return a new head with the given index and the next tag
+  static uint64_t retag(uint64_t head, uint32_t index)
+  {
+    return (((head >> 32U) + 1U) << 32U) | index;
+  }
+
+  size_t                                   _block_size; ///< Size of blocks
+  uint32_t                                 _n_blocks;   ///< Number of blocks
+  ArrayPtr<std::byte>                      _memory;     ///< Block memory
+  std::unique_ptr<std::atomic<uint32_t>[]> _next;       ///< Free list links
+
+  /// Free list head, a tag in the high 32 bits and an index in the low
+  std::atomic<uint64_t> _head;
+};
+
+} // namespace raul
+
+#endif // RAUL_ARENA_HPP
@@ -1,21 +1,26 @@
-// Copyright 2007-2025 David Robillard <d@drobilla.net>
+// Copyright 2007-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #ifndef RAUL_ARRAY_HPP
 #define RAUL_ARRAY_HPP
 
+#include <raul/AllocationPolicy.hpp>
 #include <raul/Maid.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
-#include <memory>
+#include <utility>
 
 namespace raul {
 
 /**
    A disposable array with a size.
 
+   The elements may be allocated with a non-standard AllocationPolicy, for
+   example to lock arrays used in real-time threads in memory.  Copies always
+   use the standard policy.
+
    @ingroup raul
 */
 template<class T>
@@ -25,13 +30,21 @@ public:
   explicit Array(size_t size = 0)
     : Maid::Disposable()
     , _size(size)
-    , _elems(size ? new T[size] : nullptr)
+    , _elems(allocate(size))
+  {}
+
+  Array(size_t size, AllocationPolicy policy)
+    : Maid::Disposable()
+    , _size(size)
+    , _elems(allocate(size, policy))
   {}
 
-  Array(size_t size, T initial_value)
+  Array(size_t           size,
+        T                initial_value,
+        AllocationPolicy policy = AllocationPolicy::standard)
     : Maid::Disposable()
     , _size(size)
-    , _elems(size ? new T[size] : nullptr)
+    , _elems(allocate(size, policy))
   {
     if (size > 0) {
       for (size_t i = 0; i < size; ++i) {
@@ -43,7 +56,7 @@ public:
   Array(const Array<T>& array)
     : Maid::Disposable()
     , _size(array._size)
-    , _elems(_size ? new T[_size] : nullptr)
+    , _elems(allocate(_size))
   {
     for (size_t i = 0; i < _size; ++i) {
       _elems[i] = array._elems[i];
@@ -59,11 +72,13 @@ public:
     }
 
     _size  = array._size;
-    _elems = _size ? new T[_size] : nullptr;
+    _elems = allocate(_size);
 
     for (size_t i = 0; i < _size; ++i) {
       _elems[i] = array._elems[i];
     }
+
+    return *this;
   }
 
   Array(Array<T>&& array) noexcept
@@ -80,7 +95,7 @@ public:
 
   Array(size_t size, const Array<T>& contents)
     : _size(size)
-    , _elems(size ? new T[size] : nullptr)
+    , _elems(allocate(size))
   {
     assert(contents.size() >= size);
     for (size_t i = 0; i < std::min(size, contents.size()); ++i) {
@@ -90,7 +105,7 @@ public:
 
   Array(size_t size, const Array<T>& contents, T initial_value = T())
     : _size(size)
-    , _elems(size ? new T[size] : nullptr)
+    , _elems(allocate(size))
   {
     const size_t end = std::min(size, contents.size());
     for (size_t i = 0; i < end; ++i) {
@@ -101,28 +116,21 @@ public:
     }
   }
 
-  void alloc(size_t num_elems)
+  void alloc(size_t           num_elems,
+             AllocationPolicy policy = AllocationPolicy::standard)
   {
-    _size = num_elems;
-
-    if (num_elems > 0) {
-      _elems = std::unique_ptr<T[]>(new T[num_elems]);
-    } else {
-      _elems.reset();
-    }
+    _size  = num_elems;
+    _elems = allocate(num_elems, policy);
   }
 
-  void alloc(size_t num_elems, T initial_value)
+  void alloc(size_t           num_elems,
+             T                initial_value,
+             AllocationPolicy policy = AllocationPolicy::standard)
   {
-    _size = num_elems;
-
-    if (num_elems > 0) {
-      _elems = std::unique_ptr<T[]>(new T[num_elems]);
-      for (size_t i = 0; i < _size; ++i) {
-        _elems[i] = initial_value;
-      }
-    } else {
-      _elems.reset();
+    _size  = num_elems;
+    _elems = allocate(num_elems, policy);
+    for (size_t i = 0; i < _size; ++i) {
+      _elems[i] = initial_value;
     }
   }
 
@@ -141,8 +149,14 @@ public:
   }
 
 private:
-  size_t               _size;
-  std::unique_ptr<T[]> _elems;
+  static ArrayPtr<T>
+  allocate(size_t size, AllocationPolicy policy = AllocationPolicy::standard)
+  {
+    return size ? allocate_array<T>(size, policy) : ArrayPtr<T>{};
+  }
+
+  size_t      _size;
+  ArrayPtr<T> _elems;
 };
 
 } // namespace raul
@@ -0,0 +1,453 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_AUDIORING_HPP
+#define RAUL_AUDIORING_HPP
+
+#include <raul/AllocationPolicy.hpp>
+#include <raul/detail/FreeRunningRing.hpp>
+#include <raul/detail/Util.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace raul {
+
+/**
+   A lock-free ring buffer of multi-channel audio.
+
+   Audio is stored as interleaved 32-bit float frames, and can be written and
+   read either as planar float channels, or as interleaved frames in several
+   sample formats.  Conversion happens directly between the caller's buffers
+   and the ring, so no intermediate buffer is needed to, for example, write
+   planar audio from a process callback and read interleaved 24-bit frames
+   for a disk writer.
+
+   Integer samples are converted in small blocks, where the arithmetic is
+   done by simple branch-free loops over 32-bit integers that the compiler
+   can vectorize, and only packing and unpacking 24-bit samples is done one
+   sample at a time.
+
+   Unlike RingBuffer, reads and writes transfer as many whole frames as
+   possible, and return the number of frames transferred.
+
+   Thread-safe with a single reader and single writer, and real-time safe
+   on both ends.
+
+   @ingroup raul
+*/
+class AudioRing
+{
+public:
+  /// Format of interleaved samples
+  enum class Format {
+    float32, ///< Native 32-bit float in [-1, 1]
+    int16,   ///< Native 16-bit signed integer
+    int24,   ///< Packed little-endian 24-bit signed integer
+  };
+
+  /**
+     Create a new AudioRing.
+
+     @param n_channels Number of channels, which must be at least 1.
+     @param n_frames Capacity in frames (note this may be rounded up).
+     @param policy How to allocate the contents.
+     @throw std::length_error if the ring would be larger than 2 GiB.
+     @throw std::bad_alloc if the contents can't be allocated.
+  */
+  AudioRing(uint32_t         n_channels,
+            uint32_t         n_frames,
+            AllocationPolicy policy = AllocationPolicy::standard)
+    : _n_channels(n_channels)
+    , _size(ring_size(n_channels, n_frames))
+    , _buf(allocate_array<char>(_size, policy))
+    , _ring{_heads, _buf.get(), _size}
+  {}
+
+  AudioRing(const AudioRing&)            = delete;
+  AudioRing& operator=(const AudioRing&) = delete;
+  AudioRing(AudioRing&&)                 = delete;
+  AudioRing& operator=(AudioRing&&)      = delete;
+
+  ~AudioRing() = default;
+
+  /**
+     Reset (empty) the ring.
+
+     This method is NOT thread-safe, it may only be called when there are no
+     readers or writers.
+  */
+  void reset() { _ring.reset(); }
+
+  /// Return the number of channels
+  [[nodiscard]] uint32_t n_channels() const { return _n_channels; }
+
+  /// Return the number of frames available for reading
+  [[nodiscard]] uint32_t read_space() const
+  {
+    return _ring.read_space() / frame_size();
+  }
+
+  /// Return the number of frames of space available for writing
+  [[nodiscard]] uint32_t write_space() const
+  {
+    return _ring.write_space() / frame_size();
+  }
+
+  /// Return the capacity in frames
+  [[nodiscard]] uint32_t capacity() const
+  {
+    return _ring.capacity() / frame_size();
+  }
+
+  /**
+     Write planar float channels.
+
+     @param channels Array of n_channels() pointers to channel buffers.
+     @param n_frames Number of frames to write.
+     @return The number of frames written.
+  */
+  uint32_t write_planar(const float* const* channels, uint32_t n_frames)
+  {
+    const Ring::WriteVector vec = _ring.write_vector();
+    const Split split = split_samples(vec, std::min(n_frames, frames(vec)));
+
+    float* const first  = samples(vec.first.data);
+    float* const second = samples(vec.second.data);
+
+    interleave(channels, 0U, split.n_first, first);
+    interleave(channels, split.n_first, split.n_second, second);
+
+    _ring.commit_write(split.n_frames * frame_size());
+    return split.n_frames;
+  }
+
+  /**
+     Write interleaved frames.
+
+     @param format Format of the samples in `src`.
+     @param src Interleaved frames.
+     @param n_frames Number of frames to write.
+     @return The number of frames written.
+  */
+  uint32_t
+  write_interleaved(Format format, const void* src, uint32_t n_frames)
+  {
+    const Ring::WriteVector vec = _ring.write_vector();
+    const Split split = split_samples(vec, std::min(n_frames, frames(vec)));
+
+    const auto* const bytes = static_cast<const uint8_t*>(src);
+    const size_t offset = size_t{split.n_first} * format_size(format);
+
+    to_float(format, bytes, split.n_first, samples(vec.first.data));
+    to_float(format, bytes + offset, split.n_second, samples(vec.second.data));
+
+    _ring.commit_write(split.n_frames * frame_size());
+    return split.n_frames;
+  }
+
+  /**
+     Read interleaved frames.
+
+     @param format Format of the samples to write to `dst`.
+     @param dst Buffer for interleaved frames.
+     @param n_frames Maximum number of frames to read.
+     @return The number of frames read.
+  */
+  uint32_t read_interleaved(Format format, void* dst, uint32_t n_frames)
+  {
+    const Ring::ReadVector vec = _ring.read_vector();
+    const Split split = split_samples(vec, std::min(n_frames, frames(vec)));
+
+    auto* const  bytes  = static_cast<uint8_t*>(dst);
+    const size_t offset = size_t{split.n_first} * format_size(format);
+
+    const float* const first  = samples(vec.first.data);
+    const float* const second = samples(vec.second.data);
+
+    from_float(format, first, split.n_first, bytes);
+    from_float(format, second, split.n_second, bytes + offset);
+
+    _ring.commit_read(split.n_frames * frame_size());
+    return split.n_frames;
+  }
+
+  /**
+     Read planar float channels.
+
+     @param channels Array of n_channels() pointers to channel buffers.
+     @param n_frames Maximum number of frames to read.
+     @return The number of frames read.
+  */
+  uint32_t read_planar(float* const* channels, uint32_t n_frames)
+  {
+    const Ring::ReadVector vec = _ring.read_vector();
+    const Split split = split_samples(vec, std::min(n_frames, frames(vec)));
+
+    const float* const first  = samples(vec.first.data);
+    const float* const second = samples(vec.second.data);
+
+    deinterleave(first, 0U, split.n_first, channels);
+    deinterleave(second, split.n_first, split.n_second, channels);
+
+    _ring.commit_read(split.n_frames * frame_size());
+    return split.n_frames;
+  }
+
+private:
+  using Ring = detail::FreeRunningRing<uint32_t>;
+
+  template<class Byte>
+  using Vector = detail::Vector<Byte, uint32_t>;
+
+  static constexpr uint32_t sample_size = sizeof(float);
+
+  /// Number of samples converted at once with a temporary block
+  static constexpr uint32_t block_size = 64U;
+
+  /// A number of frames split into samples in two ring segments
+  struct Split {
+    uint32_t n_frames; ///< Total number of frames
+    uint32_t n_first;  ///< Number of samples in the first segment
+    uint32_t n_second; ///< Number of samples in the second segment
+  };
+
+  /**
+     Return the size of the buffer for a capacity, or throw if it's too large.
+
+     The heads are free-running, so the whole buffer is usable, and any
+     space left over after rounding up that's large enough for more frames
+     simply adds to the capacity.
+  */
+  static uint32_t ring_size(uint32_t n_channels, uint32_t n_frames)
+  {
+    const uint64_t size =
+      std::max(uint64_t{n_frames}, uint64_t{1U}) * n_channels * sample_size;
+
+    if (size > (uint64_t{1U} << 31U)) {
+      throw std::length_error("AudioRing is too large");
+    }
+
+    return detail::next_power_of_two(static_cast<uint32_t>(size));
+  }
+
+  static uint32_t format_size(Format format)
+  {
+    return format == Format::int16 ? 2U : format == Format::int24 ? 3U : 4U;
+  }
+
+  static float* samples(char* data) { return reinterpret_cast<float*>(data); }
+
+  static const float* samples(const char* data)
+  {
+    return reinterpret_cast<const float*>(data);
+  }
+
+  [[nodiscard]] uint32_t frame_size() const
+  {
+    return _n_channels * sample_size;
+  }
+
+  template<class Byte>
+  [[nodiscard]] uint32_t frames(const Vector<Byte>& vec) const
+  {
+    return vec.size() / frame_size();
+  }
+
+  /**
+     Split frames into samples in each segment of a vector.
+
+     The buffer size is a power of two that is at least the sample size, so
+     segments contain whole samples, but a frame may be split between them.
+  */
+  template<class Byte>
+  [[nodiscard]] Split
+  split_samples(const Vector<Byte>& vec, uint32_t n_frames) const
+  {
+    const uint32_t n_samples = n_frames * _n_channels;
+    const uint32_t n_first =
+      std::min(n_samples, vec.first.size / sample_size);
+    return {n_frames, n_first, n_samples - n_first};
+  }
+
+  /**
+     Interleave part of planar channels.
+
+     @param channels Planar channels.
+     @param first Index of the first interleaved sample to write.
+     @param n_samples Number of interleaved samples to write.
+     @param dst Interleaved output, starting at sample `first`.
+  */
+  void interleave(const float* const* channels,
+                  uint32_t            first,
+                  uint32_t            n_samples,
+                  float*              dst) const
+  {
+    const uint32_t n_channels = _n_channels;
+    for (uint32_t c = 0U; c < n_channels; ++c) {
+      // Find the first sample in this range that belongs to channel c
+      const uint32_t i0 = (c + n_channels - (first % n_channels)) % n_channels;
+
+      const float* src = channels[c] + ((first + i0) / n_channels);
+      for (uint32_t i = i0; i < n_samples; i += n_channels) {
+        dst[i] = *src++;
+      }
+    }
+  }
+
+  /// Deinterleave part of interleaved samples, the inverse of interleave()
+  void deinterleave(const float*  src,
+                    uint32_t      first,
+                    uint32_t      n_samples,
+                    float* const* channels) const
+  {
+    const uint32_t n_channels = _n_channels;
+    for (uint32_t c = 0U; c < n_channels; ++c) {
+      const uint32_t i0 = (c + n_channels - (first % n_channels)) % n_channels;
+      if (i0 >= n_samples) {
+        continue;
+      }
+
+      // Index by frame so the loop count is known, which allows vectorizing
+      const uint32_t     n = (n_samples - i0 + n_channels - 1U) / n_channels;
+      const float* const s = src + i0;
+      float* const       dst = channels[c] + ((first + i0) / n_channels);
+      for (uint32_t j = 0U; j < n; ++j) {
+        dst[j] = s[size_t{j} * n_channels];
+      }
+    }
+  }
+
+  /// Convert samples in any format to float
+  static void
+  to_float(Format format, const uint8_t* src, uint32_t n_samples, float* dst)
+  {
+    switch (format) {
+    case Format::float32:
+      memcpy(dst, src, size_t{n_samples} * sizeof(float));
+      break;
+
+    case Format::int16:
+      for (uint32_t i = 0U; i < n_samples; ++i) {
+        int16_t value = 0;
+        memcpy(&value, src + (size_t{i} * 2U), sizeof(value));
+        dst[i] = static_cast<float>(value) / int16_scale;
+      }
+      break;
+
+    case Format::int24:
+      for (uint32_t i = 0U; i < n_samples; i += block_size) {
+        const uint32_t n = std::min(block_size, n_samples - i);
+        int32_t        block[block_size];
+
+        unpack_int24(src + (size_t{i} * 3U), n, block);
+        for (uint32_t j = 0U; j < n; ++j) {
+          dst[i + j] = static_cast<float>(block[j]) / int24_scale;
+        }
+      }
+      break;
+    }
+  }
+
+  /// Convert float samples to any format, clipping to [-1, 1]
+  static void
+  from_float(Format format, const float* src, uint32_t n_samples, uint8_t* dst)
+  {
+    if (format == Format::float32) {
+      memcpy(dst, src, size_t{n_samples} * sizeof(float));
+      return;
+    }
+
+    const bool  is_int16 = format == Format::int16;
+    const float scale    = is_int16 ? int16_scale : int24_scale;
+    for (uint32_t i = 0U; i < n_samples; i += block_size) {
+      const uint32_t n = std::min(block_size, n_samples - i);
+      int32_t        block[block_size];
+
+      quantize(src + i, n, scale, block);
+      if (is_int16) {
+        pack_int16(block, n, dst + (size_t{i} * 2U));
+      } else {
+        pack_int24(block, n, dst + (size_t{i} * 3U));
+      }
+    }
+  }
+
+  /// Clip samples to [-1, 1], scale them, and round to the nearest integer
+  static void
+  quantize(const float* src, uint32_t n_samples, float scale, int32_t* dst)
+  {
+    constexpr uint32_t sign_mask = 0x80000000U; // Sign bit
+    constexpr uint32_t inf_bits  = 0x7F800000U; // Magnitude of infinity
+    constexpr uint32_t one_bits  = 0x3F800000U; // Magnitude of 1.0
+
+    for (uint32_t i = 0U; i < n_samples; ++i) {
+      // Clip the magnitude as an integer, since float comparisons can trap,
+      // which stops the compiler from vectorizing them, and NaN is silence
+      uint32_t bits = 0U;
+      memcpy(&bits, &src[i], sizeof(bits));
+
+      uint32_t magnitude = bits & ~sign_mask;
+      magnitude          = magnitude > inf_bits ? 0U : magnitude;
+      magnitude          = magnitude < one_bits ? magnitude : one_bits;
+      bits               = (bits & sign_mask) | magnitude;
+
+      float clipped = 0.0f;
+      memcpy(&clipped, &bits, sizeof(clipped));
+      clipped *= scale;
+
+      dst[i] = static_cast<int32_t>(clipped + std::copysign(0.5f, clipped));
+    }
+  }
+
+  static void pack_int16(const int32_t* src, uint32_t n_samples, uint8_t* dst)
+  {
+    for (uint32_t i = 0U; i < n_samples; ++i) {
+      const auto value = static_cast<int16_t>(src[i]);
+      memcpy(dst + (size_t{i} * 2U), &value, sizeof(value));
+    }
+  }
+
+  static void pack_int24(const int32_t* src, uint32_t n_samples, uint8_t* dst)
+  {
+    for (uint32_t i = 0U; i < n_samples; ++i) {
+      const auto     bits = static_cast<uint32_t>(src[i]);
+      uint8_t* const d    = dst + (size_t{i} * 3U);
+
+      d[0] = static_cast<uint8_t>(bits);
+      d[1] = static_cast<uint8_t>(bits >> 8U);
+      d[2] = static_cast<uint8_t>(bits >> 16U);
+    }
+  }
+
+  static void
+  unpack_int24(const uint8_t* src, uint32_t n_samples, int32_t* dst)
+  {
+    for (uint32_t i = 0U; i < n_samples; ++i) {
+      const uint8_t* const s = src + (size_t{i} * 3U);
+
+      // Load into the top bits, so dividing extends the sign
+      const uint32_t bits = (uint32_t{s[0]} << 8U) | (uint32_t{s[1]} << 16U) |
+                            (uint32_t{s[2]} << 24U);
+
+      dst[i] = static_cast<int32_t>(bits) / 256;
+    }
+  }
+
+  static constexpr float int16_scale = 32767.0f;
+  static constexpr float int24_scale = 8388607.0f;
+
+  uint32_t       _n_channels; ///< Number of channels
+  uint32_t       _size;       ///< Size of the buffer in bytes
+  ArrayPtr<char> _buf;        ///< Interleaved float frames
+  Ring::Heads    _heads;      ///< Read and write heads
+  Ring           _ring;       ///< Reader and writer
+};
+
+} // namespace raul
+
+#endif // RAUL_AUDIORING_HPP
@@ -0,0 +1,239 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_BROADCASTRING_HPP
+#define RAUL_BROADCASTRING_HPP
+
+#include <raul/detail/Util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace raul {
+
+/**
+   A lock-free ring of messages with a single writer and several readers.
+
+   Every reader sees every message (as long as it keeps up), and has its own
+   read position, so readers are completely independent.  The writer never
+   waits for readers: it always overwrites the oldest message, so a reader
+   that falls more than a full ring behind loses messages.  Readers detect
+   this with a sequence number in every slot, skip ahead to the oldest
+   message that is still intact, and count how many were lost.
+
+   Messages are stored in fixed-size slots, so this is best suited to small
+   messages of similar size, like meter or scope blocks.
+
+   Writing is wait-free and real-time safe.  Reading is lock-free and
+   real-time safe, since a reader only retries if it is lapped.
+
+   @ingroup raul
+*/
+class BroadcastRing
+{
+public:
+  /**
+     A reader with its own position in a BroadcastRing.
+
+     Each reader may only be used by one thread at a time.
+  */
+  class Reader
+  {
+  public:
+    /// Create a reader which starts at the next message to be written
+    explicit Reader(const BroadcastRing& ring)
+      : _ring{&ring}
+      , _pos{ring._write_pos.load(std::memory_order_acquire)}
+    {}
+
+    /// Return the number of messages that are available for reading
+    [[nodiscard]] uint64_t read_space() const
+    {
+      const uint64_t w = _ring->_write_pos.load(std::memory_order_acquire);
+      return w - _pos > _ring->_n_slots ? _ring->_n_slots : w - _pos;
+    }
+
+    /// Return the number of messages lost by being lapped by the writer
+    [[nodiscard]] uint64_t lost() const { return _lost; }
+
+    /**
+       Read the next message.
+
+       @param size Size of `dst` in bytes.  Messages larger than this are
+       skipped and counted as lost.
+       @param dst Buffer to copy the message into.
+       @return The size of the message, or zero if there is no message.
+    */
+    uint32_t read(uint32_t size, void* dst)
+    {
+      for (;;) {
+        const std::atomic<uint64_t>* const slot     = _ring->slot(_pos);
+        const uint64_t                     expected = published_seq(_pos);
+
+        const uint64_t seq = slot[0].load(std::memory_order_acquire);
+        if (seq < expected) {
+          return 0U; // Not written yet
+        }
+
+        if (seq == expected) {
+          const auto msg_size =
+            static_cast<uint32_t>(slot[1].load(std::memory_order_relaxed));
+
+          if (msg_size <= size) {
+            load_words(slot + 2U, msg_size, static_cast<char*>(dst));
+          }
+
+          // Check that the writer didn't start overwriting while we copied
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (slot[0].load(std::memory_order_relaxed) == expected) {
+            ++_pos;
+            if (msg_size <= size) {
+              return msg_size;
+            }
+
+            ++_lost;
+            continue;
+          }
+        }
+
+        resync();
+      }
+    }
+
+  private:
+    /// Skip ahead to the oldest message that is still intact
+    void resync()
+    {
+      const uint64_t w = _ring->_write_pos.load(std::memory_order_acquire);
+      const uint64_t n = _ring->_n_slots;
+
+      // The oldest slot is about to be overwritten, so skip one more
+      const uint64_t oldest = w > n ? w - n + 1U : 0U;
+      if (oldest > _pos) {
+        _lost += oldest - _pos;
+        _pos = oldest;
+      }
+    }
+
+    static void
+    load_words(const std::atomic<uint64_t>* src, uint32_t size, char* dst)
+    {
+      for (uint32_t offset = 0U; offset < size; offset += word_size) {
+        const uint64_t word = src->load(std::memory_order_relaxed);
+        memcpy(dst + offset, &word, std::min(word_size, size - offset));
+        ++src;
+      }
+    }
+
+    const BroadcastRing* _ring;    ///< Ring being read
+    uint64_t             _pos;     ///< Position of the next message to read
+    uint64_t             _lost{0}; ///< Number of messages lost
+  };
+
+  /**
+     Create a new BroadcastRing.
+
+     @param n_slots Number of messages (note this may be rounded up).
+     @param slot_size Maximum size of a message in bytes.
+  */
+  BroadcastRing(uint32_t n_slots, uint32_t slot_size)
+    : _n_slots(detail::next_power_of_two(n_slots < 2U ? 2U : n_slots))
+    , _slot_mask(_n_slots - 1U)
+    , _slot_size(slot_size)
+    , _stride(2U + ((slot_size + word_size - 1U) / word_size))
+    , _words(new std::atomic<uint64_t>[size_t{_n_slots} * _stride]())
+  {}
+
+  BroadcastRing(const BroadcastRing&)            = delete;
+  BroadcastRing& operator=(const BroadcastRing&) = delete;
+  BroadcastRing(BroadcastRing&&)                 = delete;
+  BroadcastRing& operator=(BroadcastRing&&)      = delete;
+
+  ~BroadcastRing() = default;
+
+  /// Return the number of message slots
+  [[nodiscard]] uint32_t n_slots() const { return _n_slots; }
+
+  /// Return the maximum size of a message in bytes
+  [[nodiscard]] uint32_t slot_size() const { return _slot_size; }
+
+  /// Return the total number of messages written
+  [[nodiscard]] uint64_t n_written() const
+  {
+    return _write_pos.load(std::memory_order_relaxed);
+  }
+
+  /**
+     Write a message, overwriting the oldest if necessary.
+
+     This may only be called by the writer.
+
+     @return True on success, or false if `size` is larger than slot_size().
+  */
+  bool write(uint32_t size, const void* src)
+  {
+    if (size > _slot_size) {
+      return false;
+    }
+
+    const uint64_t pos = _write_pos.load(std::memory_order_relaxed);
+    std::atomic<uint64_t>* const slot = this->slot(pos);
+
+    // Mark the slot as being written (odd), then write the contents
+    slot[0].store(published_seq(pos) - 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot[1].store(size, std::memory_order_relaxed);
+    store_words(static_cast<const char*>(src), size, slot + 2U);
+
+    // Publish the message
+    slot[0].store(published_seq(pos), std::memory_order_release);
+    _write_pos.store(pos + 1U, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static constexpr uint32_t word_size = sizeof(uint64_t);
+
+  /// Return the sequence number of a slot once message `pos` is written
+  static uint64_t published_seq(uint64_t pos) { return (pos + 1U) * 2U; }
+
+  /**
+     Return the slot for message `pos`.
+
+     Each slot is a sequence number, a size, then the contents, all stored in
+     atomic words so that readers can safely read while the writer writes.
+  */
+  [[nodiscard]] std::atomic<uint64_t>* slot(uint64_t pos) const
+  {
+    return &_words[(pos & _slot_mask) * _stride];
+  }
+
+  static void
+  store_words(const char* src, uint32_t size, std::atomic<uint64_t>* dst)
+  {
+    for (uint32_t offset = 0U; offset < size; offset += word_size) {
+      uint64_t word = 0U;
+      memcpy(&word, src + offset, std::min(word_size, size - offset));
+      dst->store(word, std::memory_order_relaxed);
+      ++dst;
+    }
+  }
+
+  // Shared and constant after construction
+  uint32_t                                 _n_slots;   ///< Number of slots
+  uint32_t                                 _slot_mask; ///< Mask for modulo
+  uint32_t                                 _slot_size; ///< Max message size
+  uint32_t                                 _stride;    ///< Words per slot
+  std::unique_ptr<std::atomic<uint64_t>[]> _words;     ///< Contents
+
+  /// Position of the next message to write, written only by the writer
+  std::atomic<uint64_t> _write_pos{0U};
+};
+
+} // namespace raul
+
+#endif // RAUL_BROADCASTRING_HPP
@@ -0,0 +1,273 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_EPOCHMAID_HPP
+#define RAUL_EPOCHMAID_HPP
+
+#include <raul/Maid.hpp>
+#include <raul/detail/Util.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace raul {
+
+/**
+   Garbage collector for objects that may still be in use by readers.
+
+   This is a companion to Maid for lock-free structures that other threads
+   may still be reading when an object is removed, like lookup tables or
+   graph snapshots which are read concurrently by several worker threads.
+   A retired object is only deleted once every reader that might have seen
+   it has finished reading.
+
+   This uses epoch-based reclamation.  Readers announce the current epoch
+   when they start reading, and the epoch can only advance once all active
+   readers have announced it.  Objects retired in an epoch are deleted
+   once the epoch has advanced twice, since by then no reader can still be
+   reading from before they were retired.
+
+   Each reader thread needs a Reader, which is registered in one of a fixed
+   number of slots, and locked while reading:
+
+   @code
+   EpochMaid::Reader reader{epoch_maid};
+   {
+     const std::lock_guard<EpochMaid::Reader> guard{reader};
+     // Read shared structures here
+   }
+   @endcode
+
+   Reading and retiring are lock-free and real-time safe.  A reader that
+   stays locked for a long time delays deleting everything retired since,
+   so critical sections should be short.
+
+   @ingroup raul
+*/
+class EpochMaid
+{
+public:
+  /**
+     A reader registered with an EpochMaid.
+
+     This meets the BasicLockable requirements, so it can be used with
+     std::lock_guard.  Locks can't be nested, and each reader may only be
+     used by one thread at a time.
+  */
+  class Reader
+  {
+  public:
+    /**
+       Register a new reader.
+
+       @throw std::runtime_error if there are no free reader slots.
+    */
+    explicit Reader(EpochMaid& maid)
+      : _slot{maid.claim_slot()}
+      , _epoch{&maid._epoch}
+    {}
+
+    Reader(const Reader&)            = delete;
+    Reader& operator=(const Reader&) = delete;
+    Reader(Reader&&)                 = delete;
+    Reader& operator=(Reader&&)      = delete;
+
+    ~Reader() { _slot->store(slot_free, std::memory_order_release); }
+
+    /// Start reading, announcing the current epoch
+    void lock()
+    {
+      uint64_t epoch = _epoch->load(std::memory_order_relaxed);
+      for (;;) {
+        // Announce the epoch before reading anything shared
+        _slot->store(active_state(epoch), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Announce again if the epoch advanced before we announced it
+        const uint64_t current = _epoch->load(std::memory_order_relaxed);
+        if (current == epoch) {
+          break;
+        }
+
+        epoch = current;
+      }
+    }
+
+    /// Finish reading
+    void unlock() { _slot->store(slot_idle, std::memory_order_release); }
+
+  private:
+    std::atomic<uint64_t>*       _slot;  ///< Slot for this reader
+    const std::atomic<uint64_t>* _epoch; ///< Global epoch
+  };
+
+  /**
+     Create a new EpochMaid.
+
+     @param max_readers Maximum number of readers registered at once.
+  */
+  explicit EpochMaid(size_t max_readers)
+    : _n_slots{max_readers}
+    , _slots{new Slot[max_readers]}
+  {}
+
+  EpochMaid(const EpochMaid&)            = delete;
+  EpochMaid& operator=(const EpochMaid&) = delete;
+  EpochMaid(EpochMaid&&)                 = delete;
+  EpochMaid& operator=(EpochMaid&&)      = delete;
+
+  /// Delete all retired objects, which requires that no readers are locked
+  ~EpochMaid()
+  {
+    Disposable* retired = _retired.exchange(nullptr, std::memory_order_acquire);
+    delete_list(retired);
+    for (Disposable*& limbo : _limbo) {
+      delete_list(limbo);
+    }
+  }
+
+  /// Return false iff there is currently no garbage (cleanup thread only)
+  [[nodiscard]] bool empty() const
+  {
+    return !_retired.load(std::memory_order_relaxed) && !_limbo[0] &&
+           !_limbo[1] && !_limbo[2];
+  }
+
+  /**
+     Retire an object which has been removed from any shared structure.
+
+     The object is deleted by cleanup() once no reader can still be using
+     it.  This is thread-safe, and real-time safe assuming reasonably low
+     contention.
+  */
+  void retire(Maid::Disposable* obj)
+  {
+    if (obj) {
+      Disposable* head = _retired.load(std::memory_order_relaxed);
+      do {
+        obj->_maid_next.store(head, std::memory_order_relaxed);
+      } while (!_retired.compare_exchange_weak(head,
+                                               obj,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+  }
+
+  /**
+     Advance the epoch if possible, and delete objects that are now safe.
+
+     Without any locked readers, this deletes every object retired before
+     it was called.  Otherwise, objects are deleted by a later call, once
+     the readers have unlocked.
+
+     Not real-time safe, and may only be called by one thread at a time.
+  */
+  void cleanup()
+  {
+    // Objects retired so far belong to (at least) the current epoch
+    const uint64_t epoch = _epoch.load(std::memory_order_relaxed);
+    append(_limbo[epoch % 3U],
+           _retired.exchange(nullptr, std::memory_order_acquire));
+
+    // Advance at most twice, which is enough to delete what was just taken
+    for (unsigned i = 0U; i < 2U && try_advance(); ++i) {
+      // Objects from two epochs ago are no longer reachable by any reader
+      const uint64_t current = _epoch.load(std::memory_order_relaxed);
+      delete_list(_limbo[(current + 1U) % 3U]);
+    }
+  }
+
+private:
+  using Disposable = Maid::Disposable;
+
+  static constexpr uint64_t slot_free = 0U; ///< Slot with no reader
+  static constexpr uint64_t slot_idle = 1U; ///< Slot with an unlocked reader
+
+  /// Return the state of a slot whose reader is locked in `epoch`
+  static uint64_t active_state(uint64_t epoch) { return (epoch << 2U) | 2U; }
+
+  /// A reader slot, on its own cache line
+  struct Slot {
+    alignas(detail::cache_line_size) std::atomic<uint64_t> state{slot_free};
+  };
+
+  /// Claim a free slot for a reader
+  std::atomic<uint64_t>* claim_slot()
+  {
+    for (size_t i = 0U; i < _n_slots; ++i) {
+      uint64_t expected = slot_free;
+      if (_slots[i].state.compare_exchange_strong(expected,
+                                                  slot_idle,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+        return &_slots[i].state;
+      }
+    }
+
+    throw std::runtime_error("No free EpochMaid reader slots");
+  }
+
+  /// Advance the epoch if every locked reader has announced it
+  bool try_advance()
+  {
+    const uint64_t epoch = _epoch.load(std::memory_order_relaxed);
+
+    // Pair with the fence in Reader::lock()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (size_t i = 0U; i < _n_slots; ++i) {
+      const uint64_t state = _slots[i].state.load(std::memory_order_acquire);
+      if ((state & 2U) && state != active_state(epoch)) {
+        return false; // Reader is still in an older epoch
+      }
+    }
+
+    _epoch.store(epoch + 1U, std::memory_order_seq_cst);
+    return true;
+  }
+
+  /// Append a list of objects to another
+  static void append(Disposable*& list, Disposable* objs)
+  {
+    if (objs) {
+      Disposable* last = objs;
+      while (Disposable* const next =
+               last->_maid_next.load(std::memory_order_relaxed)) {
+        last = next;
+      }
+
+      last->_maid_next.store(list, std::memory_order_relaxed);
+      list = objs;
+    }
+  }
+
+  /// Delete every object in a list, and clear it
+  static void delete_list(Disposable*& list)
+  {
+    for (Disposable* obj = list; obj;) {
+      Disposable* const next = obj->_maid_next.load(std::memory_order_relaxed);
+      delete obj;
+      obj = next;
+    }
+
+    list = nullptr;
+  }
+
+  size_t                  _n_slots; ///< Number of reader slots
+  std::unique_ptr<Slot[]> _slots;   ///< Reader slots
+
+  /// Current epoch, read by readers and advanced by cleanup()
+  alignas(detail::cache_line_size) std::atomic<uint64_t> _epoch{0U};
+
+  /// Objects retired since the last cleanup(), written by any thread
+  alignas(detail::cache_line_size) std::atomic<Disposable*> _retired{nullptr};
+
+  /// Objects retired in each epoch (modulo 3), only used by cleanup()
+  Disposable* _limbo[3]{};
+};
+
+} // namespace raul
+
+#endif // RAUL_EPOCHMAID_HPP
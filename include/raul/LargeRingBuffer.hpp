@@ -0,0 +1,144 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_LARGERINGBUFFER_HPP
+#define RAUL_LARGERINGBUFFER_HPP
+
+#include <raul/detail/FreeRunningRing.hpp>
+#include <raul/detail/Util.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace raul {
+
+/**
+   A lock-free ring buffer with 64-bit sizes.
+
+   This is like RingBuffer, but the heads are free-running 64-bit byte
+   counts which are only masked when accessing the buffer.  This means that
+   the full size of the buffer can be used, sizes are not limited to 32 bits
+   (for streaming to or from disk, for example), and the heads double as
+   counts of the total number of bytes ever written and read.
+
+   Thread-safe with a single reader and single writer, and real-time safe
+   on both ends.
+
+   @ingroup raul
+*/
+class LargeRingBuffer
+{
+public:
+  /// A contiguous region of the buffer
+  template<class Byte>
+  using Segment = detail::Segment<Byte, uint64_t>;
+
+  /// A region of the buffer which may wrap around the end, see RingBuffer
+  template<class Byte>
+  using Vector = detail::Vector<Byte, uint64_t>;
+
+  using WriteVector = Vector<char>;       ///< Writable space
+  using ReadVector  = Vector<const char>; ///< Readable data
+
+  /**
+     Create a new LargeRingBuffer.
+
+     @param size Size in bytes (note this may be rounded up).
+     @throw std::length_error if the size is too large for this platform.
+     @throw std::bad_alloc if the contents can't be allocated.
+  */
+  explicit LargeRingBuffer(uint64_t size)
+    : _size(ring_size(size))
+    , _buf(new char[detail::to_size(_size)])
+    , _ring{_heads, _buf.get(), _size}
+  {
+    assert(read_space() == 0U);
+    assert(write_space() == _size);
+  }
+
+  LargeRingBuffer(const LargeRingBuffer&)            = delete;
+  LargeRingBuffer& operator=(const LargeRingBuffer&) = delete;
+  LargeRingBuffer(LargeRingBuffer&&)                 = delete;
+  LargeRingBuffer& operator=(LargeRingBuffer&&)      = delete;
+
+  ~LargeRingBuffer() = default;
+
+  /**
+     Reset (empty) the ring, including the total counts.
+
+     This method is NOT thread-safe, it may only be called when there are no
+     readers or writers.
+  */
+  void reset() { _ring.reset(); }
+
+  /// Return the number of bytes of space available for reading
+  [[nodiscard]] uint64_t read_space() const { return _ring.read_space(); }
+
+  /// Return the number of bytes of space available for writing
+  [[nodiscard]] uint64_t write_space() const { return _ring.write_space(); }
+
+  /// Return the capacity (i.e. total write space when empty)
+  [[nodiscard]] uint64_t capacity() const { return _size; }
+
+  /// Return the total number of bytes written since creation or reset
+  [[nodiscard]] uint64_t total_written() const { return _ring.write_head(); }
+
+  /// Return the total number of bytes read since creation or reset
+  [[nodiscard]] uint64_t total_read() const { return _ring.read_head(); }
+
+  /// Read from the ring without advancing the read head
+  uint64_t peek(uint64_t size, void* dst) { return _ring.peek(size, dst); }
+
+  /// Read from the ring and advance the read head
+  uint64_t read(uint64_t size, void* dst) { return _ring.read(size, dst); }
+
+  /// Skip data in the ring (advance read head without reading)
+  uint64_t skip(uint64_t size) { return _ring.skip(size); }
+
+  /// Write data to the ring
+  uint64_t write(uint64_t size, const void* src)
+  {
+    return _ring.write(size, src);
+  }
+
+  /// Return all space currently available for writing
+  WriteVector write_vector() { return _ring.write_vector(); }
+
+  /// Advance the write head after writing to a write_vector()
+  void commit_write(uint64_t size) { _ring.commit_write(size); }
+
+  /// Return all data currently available for reading
+  ReadVector read_vector() { return _ring.read_vector(); }
+
+  /// Advance the read head after reading from a read_vector()
+  void commit_read(uint64_t size) { _ring.commit_read(size); }
+
+private:
+  using Ring = detail::FreeRunningRing<uint64_t>;
+
+  /// Return the size of the buffer for a requested size
+  static uint64_t ring_size(uint64_t size)
+  {
+    // The largest power of two that fits in both uint64_t and size_t
+    constexpr uint64_t max_size = (uint64_t{SIZE_MAX} >> 1U) + 1U;
+
+    if (size > max_size) {
+      throw std::length_error("Ring buffer size is too large");
+    }
+
+    return detail::next_power_of_two(std::max(size, uint64_t{1U}));
+  }
+
+  uint64_t                _size;  ///< Size (capacity) in bytes
+  std::unique_ptr<char[]> _buf;   ///< Contents
+  Ring::Heads             _heads; ///< Read and write heads
+  Ring                    _ring;  ///< Reader and writer
+};
+
+} // namespace raul
+
+#endif // RAUL_LARGERINGBUFFER_HPP
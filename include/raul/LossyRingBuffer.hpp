@@ -0,0 +1,213 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_LOSSYRINGBUFFER_HPP
+#define RAUL_LOSSYRINGBUFFER_HPP
+
+#include <raul/detail/Util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace raul {
+
+/**
+   A lock-free ring buffer of messages that overwrites the oldest when full.
+
+   Unlike RingBuffer, writing never fails for lack of space: the writer
+   simply drops the oldest messages to make room.  This is the right policy
+   for things like logs and meters, where the newest data matters most, and
+   the writer should never have to deal with a full buffer.
+
+   The reader always resumes at a message boundary, and can check how many
+   messages it has lost with lost().  Every message has a sequence number, so
+   this count is exact.
+
+   Writing is wait-free and real-time safe.  Reading is lock-free and
+   real-time safe, since the reader only retries if the writer overwrites
+   the message it is reading.
+
+   @ingroup raul
+*/
+class LossyRingBuffer
+{
+public:
+  /**
+     Create a new LossyRingBuffer.
+
+     @param size Size in bytes (note this may be rounded up).
+  */
+  explicit LossyRingBuffer(uint32_t size)
+    : _n_words(detail::next_power_of_two(std::max(size / word_size, 2U)))
+    , _word_mask(_n_words - 1U)
+    , _words(new std::atomic<uint64_t>[_n_words]())
+  {}
+
+  LossyRingBuffer(const LossyRingBuffer&)            = delete;
+  LossyRingBuffer& operator=(const LossyRingBuffer&) = delete;
+  LossyRingBuffer(LossyRingBuffer&&)                 = delete;
+  LossyRingBuffer& operator=(LossyRingBuffer&&)      = delete;
+
+  ~LossyRingBuffer() = default;
+
+  /// Return the largest message size that can be written
+  [[nodiscard]] uint32_t capacity() const
+  {
+    return (_n_words - 1U) * word_size;
+  }
+
+  /**
+     Write a message, dropping the oldest messages if necessary.
+
+     This may only be called by the writer.
+
+     @param size Size of the message in bytes, which must be at least 1.
+     @param src Message to copy into the buffer.
+     @return True on success, or false if `size` is zero or larger than
+     capacity().
+  */
+  bool write(uint32_t size, const void* src)
+  {
+    if (!size || size > capacity()) {
+      return false;
+    }
+
+    const uint64_t n_words = message_words(size);
+    const uint64_t head    = _head.load(std::memory_order_relaxed);
+    uint64_t       tail    = _tail.load(std::memory_order_relaxed);
+    if (head + n_words - tail > _n_words) {
+      // Drop the oldest messages until there is enough space
+      while (head + n_words - tail > _n_words) {
+        const uint64_t header = word(tail).load(std::memory_order_relaxed);
+        tail += message_words(header_size(header));
+      }
+
+      // Move the tail before overwriting, so the reader can detect it
+      _tail.store(tail, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    // Write the header and contents
+    const auto* const bytes  = static_cast<const char*>(src);
+    const uint64_t    header = (uint64_t{_seq} << 32U) | size;
+    word(head).store(header, std::memory_order_relaxed);
+    for (uint32_t offset = 0U, i = 1U; offset < size; offset += word_size) {
+      uint64_t value = 0U;
+      memcpy(&value, bytes + offset, std::min(word_size, size - offset));
+      word(head + i++).store(value, std::memory_order_relaxed);
+    }
+
+    ++_seq;
+    _head.store(head + n_words, std::memory_order_release);
+    return true;
+  }
+
+  /**
+     Read the next message.
+
+     This may only be called by the reader.
+
+     @param size Size of `dst` in bytes.  Messages larger than this are
+     skipped and counted as lost.
+     @param dst Buffer to copy the message into.
+     @return The size of the message, or zero if there is no message.
+  */
+  uint32_t read(uint32_t size, void* dst)
+  {
+    auto* const bytes = static_cast<char*>(dst);
+    for (;;) {
+      const uint64_t head = _head.load(std::memory_order_acquire);
+      if (_read_pos == head) {
+        return 0U;
+      }
+
+      if (_read_pos < _tail.load(std::memory_order_acquire)) {
+        _read_pos = _tail.load(std::memory_order_acquire);
+        continue;
+      }
+
+      // Copy the message, which may be overwritten at any time
+      const uint64_t header   = word(_read_pos).load(std::memory_order_relaxed);
+      const uint32_t msg_size = header_size(header);
+      if (msg_size <= size) {
+        for (uint32_t offset = 0U, i = 1U; offset < msg_size;
+             offset += word_size) {
+          const uint64_t value =
+            word(_read_pos + i++).load(std::memory_order_relaxed);
+
+          memcpy(
+            bytes + offset, &value, std::min(word_size, msg_size - offset));
+        }
+      }
+
+      // Check that the writer hasn't dropped the message while we copied it
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (_read_pos < _tail.load(std::memory_order_relaxed)) {
+        continue;
+      }
+
+      // Count any messages lost since the last one read
+      const auto seq = static_cast<uint32_t>(header >> 32U);
+      _lost += seq - _next_seq;
+      _next_seq = seq + 1U;
+      _read_pos += message_words(msg_size);
+      if (msg_size <= size) {
+        return msg_size;
+      }
+
+      ++_lost;
+    }
+  }
+
+  /// Return the number of messages the reader has lost (reader only)
+  [[nodiscard]] uint64_t lost() const { return _lost; }
+
+private:
+  static constexpr uint32_t word_size = sizeof(uint64_t);
+
+  /// Return the number of words used by a message, including the header
+  static uint64_t message_words(uint32_t size)
+  {
+    return 1U + ((uint64_t{size} + word_size - 1U) / word_size);
+  }
+
+  /// Return the message size from a header word (sequence << 32 | size)
+  static uint32_t header_size(uint64_t header)
+  {
+    return static_cast<uint32_t>(header & 0xFFFFFFFFU);
+  }
+
+  std::atomic<uint64_t>& word(uint64_t pos) { return _words[pos & _word_mask]; }
+
+  // Shared and constant after construction
+  uint32_t                                 _n_words;   ///< Size in words
+  uint32_t                                 _word_mask; ///< Mask for modulo
+  std::unique_ptr<std::atomic<uint64_t>[]> _words;     ///< Contents
+
+  // Written by the writer, on a separate cache line from the reader's state
+
+  /// Free-running word position of the next message to write
+  alignas(detail::cache_line_size) std::atomic<uint64_t> _head{0U};
+
+  /// Free-running word position of the oldest intact message
+  std::atomic<uint64_t> _tail{0U};
+
+  /// Sequence number of the next message to write
+  uint32_t _seq{0U};
+
+  // Written by the reader, on a separate cache line from the writer's state
+
+  /// Free-running word position of the next message to read
+  alignas(detail::cache_line_size) uint64_t _read_pos{0U};
+
+  uint32_t _next_seq{0U}; ///< Sequence number of the next message expected
+  uint64_t _lost{0U};     ///< Number of messages lost
+};
+
+} // namespace raul
+
+#endif // RAUL_LOSSYRINGBUFFER_HPP
@@ -1,17 +1,30 @@
-// Copyright 2007-2017 David Robillard <d@drobilla.net>
+// Copyright 2007-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #ifndef RAUL_MAID_HPP
 #define RAUL_MAID_HPP
 
+#include <raul/Arena.hpp>
 #include <raul/Deletable.hpp>
+#include <raul/Semaphore.hpp>
+#include <raul/detail/Util.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
 namespace raul {
 
+class EpochMaid;
+
 /**
    Explicit garbage collector.
 
@@ -21,10 +34,37 @@ namespace raul {
    with a managed_ptr which can safely be dropped in any thread, including
    real-time threads.
 
+   Disposed objects are spread over several lists, and each thread always
+   uses the same one, so threads disposing at the same time rarely touch the
+   same cache line, and disposing is wait-free.
+
+   Instead of calling cleanup() from an existing thread, a collector thread
+   can be started with start_collector(), which deletes garbage in batches
+   to spread the cost of deleting large amounts of garbage over time.
+
+   Objects that readers may hold onto for a long time, like a sample bank
+   being played by a voice, can be protected with a Hazard.  If a protected
+   object is disposed, cleanup() defers deleting it until it is no longer
+   protected, without delaying anything else.
+
+   Objects of any type can also be disposed, without inheriting from
+   Disposable, if the Maid is created with a pool of nodes to hold them.
+
+   Objects that have several owners can be managed with a
+   managed_shared_ptr, which disposes of the object when the last reference
+   is dropped, in whatever thread that happens to be.
+
+   Statistics about the garbage, like how much is waiting and how long it
+   waits, can be read from any thread with stats(), which is useful for
+   tuning how often to clean up.
+
    @ingroup raul
 */
 class Maid
 {
+  class SharedCount;
+  struct HazardRecord;
+
 public:
   /// An object that can be disposed via Maid::dispose()
   class Disposable : public Deletable
@@ -40,8 +80,9 @@ public:
     ~Disposable() override = default;
 
   private:
+    friend class EpochMaid;
     friend class Maid;
-    Disposable* _maid_next{};
+    std::atomic<Disposable*> _maid_next{};
   };
 
   /// Disposable wrapper for any type
@@ -71,7 +112,7 @@ public:
     void operator()(T* obj)
     {
       if (_maid) {
-        _maid->dispose(obj);
+        _maid->dispose(obj, sizeof(T));
       }
     }
 
@@ -88,8 +129,239 @@ public:
   template<typename T>
   using managed_ptr = std::unique_ptr<T, Disposer<T>>;
 
-  Maid()
-    : _disposed(nullptr)
+  /**
+     A shared managed pointer that disposes of its contents.
+
+     This works like a std::shared_ptr, except the object is disposed of
+     when the last reference is dropped, so any thread, including real-time
+     threads, can safely drop a reference.  The reference count is allocated
+     along with the object, so objects must be created with
+     make_managed_shared().  Like a managed_ptr, this must not outlive the
+     Maid that created it.
+  */
+  template<typename T>
+  class managed_shared_ptr
+  {
+  public:
+    managed_shared_ptr() noexcept = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    managed_shared_ptr(std::nullptr_t) noexcept {}
+
+    managed_shared_ptr(const managed_shared_ptr& ptr) noexcept
+      : _ptr{ptr._ptr}
+      , _count{ptr._count}
+    {
+      retain();
+    }
+
+    managed_shared_ptr(managed_shared_ptr&& ptr) noexcept
+      : _ptr{std::exchange(ptr._ptr, nullptr)}
+      , _count{std::exchange(ptr._count, nullptr)}
+    {}
+
+    /// Convert from a pointer to a derived type
+    template<class U,
+             class = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    managed_shared_ptr(const managed_shared_ptr<U>& ptr) noexcept
+      : _ptr{ptr._ptr}
+      , _count{ptr._count}
+    {
+      retain();
+    }
+
+    /// Convert from a pointer to a derived type
+    template<class U,
+             class = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    managed_shared_ptr(managed_shared_ptr<U>&& ptr) noexcept
+      : _ptr{std::exchange(ptr._ptr, nullptr)}
+      , _count{std::exchange(ptr._count, nullptr)}
+    {}
+
+    managed_shared_ptr& operator=(managed_shared_ptr ptr) noexcept
+    {
+      swap(ptr);
+      return *this;
+    }
+
+    ~managed_shared_ptr() { release(); }
+
+    /// Drop this reference, and dispose of the object if it was the last
+    void reset() noexcept { managed_shared_ptr{}.swap(*this); }
+
+    /// Swap the contents of this pointer with another
+    void swap(managed_shared_ptr& other) noexcept
+    {
+      std::swap(_ptr, other._ptr);
+      std::swap(_count, other._count);
+    }
+
+    /// Return the number of references to the object, or zero if null
+    [[nodiscard]] size_t use_count() const noexcept
+    {
+      return _count ? _count->use_count() : 0U;
+    }
+
+    [[nodiscard]] T* get() const noexcept { return _ptr; }
+
+    T& operator*() const noexcept { return *_ptr; }
+    T* operator->() const noexcept { return _ptr; }
+
+    explicit operator bool() const noexcept { return _ptr; }
+
+  private:
+    template<class U>
+    friend class managed_shared_ptr;
+
+    friend class Maid;
+
+    /// Adopt the initial reference to a new object
+    managed_shared_ptr(T* ptr, SharedCount* count) noexcept
+      : _ptr{ptr}
+      , _count{count}
+    {}
+
+    void retain() noexcept
+    {
+      if (_count) {
+        _count->retain();
+      }
+    }
+
+    void release() noexcept
+    {
+      if (_count) {
+        _count->release();
+      }
+    }
+
+    T*           _ptr{nullptr};   ///< Referenced object
+    SharedCount* _count{nullptr}; ///< Reference count of the object
+  };
+
+  /**
+     A hazard pointer, which protects one object from being deleted.
+
+     A reader that loads a Disposable object from a shared atomic pointer
+     can protect it, so that if another thread replaces and disposes it,
+     cleanup() leaves it alone until the reader is finished.
+
+     Creating a hazard may allocate, so should be done in advance, but
+     protecting objects is lock-free and real-time safe.  Each hazard may only
+     be used by one thread at a time, and must be destroyed before the Maid.
+  */
+  class Hazard
+  {
+  public:
+    /// @throw std::bad_alloc if a new hazard record can't be allocated
+    explicit Hazard(Maid& maid)
+      : _record{maid.acquire_hazard()}
+    {}
+
+    Hazard(const Hazard&)            = delete;
+    Hazard& operator=(const Hazard&) = delete;
+    Hazard(Hazard&&)                 = delete;
+    Hazard& operator=(Hazard&&)      = delete;
+
+    ~Hazard()
+    {
+      reset();
+      _record->in_use.store(false, std::memory_order_release);
+    }
+
+    /**
+       Load and protect the object pointed to by `src`.
+
+       The returned object may be used until this is called again, reset()
+       is called, or the hazard is destroyed, even if another thread has
+       disposed of it in the meantime.
+    */
+    template<class T>
+    T* protect(const std::atomic<T*>& src)
+    {
+      T* obj = src.load(std::memory_order_relaxed);
+      for (;;) {
+        // Release, so reading the previously protected object is finished
+        _record->ptr.store(obj, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Check that the object wasn't replaced before it was protected
+        T* const current = src.load(std::memory_order_acquire);
+        if (current == obj) {
+          return obj;
+        }
+
+        obj = current;
+      }
+    }
+
+    /// Stop protecting the current object
+    void reset() { _record->ptr.store(nullptr, std::memory_order_release); }
+
+  private:
+    HazardRecord* _record;
+  };
+
+  /// Options for the collector thread started by start_collector()
+  struct CollectorOptions {
+    /// Time to wait between cleanups
+    std::chrono::milliseconds period{100};
+
+    /// Maximum number of objects to delete in each cleanup
+    size_t batch_size{SIZE_MAX};
+
+    /**
+       Number of pending objects that wakes the collector early, or zero.
+
+       This is checked per list, where each list is used by one or more
+       threads, so it's only approximate if there are many threads.
+    */
+    size_t threshold{0U};
+  };
+
+  /**
+     Statistics about garbage collection.
+
+     Nothing is stored in objects or timed when disposing, so sizes and
+     latencies are estimates.  The backlog size is estimated from the mean
+     size of all disposed objects, where only the static size of objects is
+     known, and objects disposed without a size count as zero.
+
+     Latencies are estimated by cleanup(), which notes how many objects have
+     been pushed to each list every time it runs, so each deleted object is
+     known to have been disposed between two cleanups.  The mean assumes the
+     middle of that interval, so it is within half the time between cleanups
+     of the truth, and the maximum uses the start, so it is an upper bound.
+     Objects that were deferred by a Hazard aren't timed.
+  */
+  struct Stats {
+    size_t n_disposed{0U};    ///< Number of objects disposed
+    size_t n_freed{0U};       ///< Number of disposed objects deleted
+    size_t backlog{0U};       ///< Number of objects waiting to be deleted
+    size_t peak_backlog{0U};  ///< Largest backlog so far
+    size_t backlog_bytes{0U}; ///< Estimated size of waiting objects
+
+    /// Estimated mean time between disposing and deleting objects
+    std::chrono::nanoseconds mean_latency{0};
+
+    /// Estimated longest time between disposing and deleting an object
+    std::chrono::nanoseconds max_latency{0};
+  };
+
+  /**
+     Create a new Maid.
+
+     @param n_nodes Number of nodes to preallocate for disposing objects of
+     any type, which limits how many can be pending at once.
+
+     @throw std::runtime_error if the collector semaphore can't be created.
+     @throw std::bad_alloc if the nodes can't be allocated.
+  */
+  explicit Maid(uint32_t n_nodes = 0U)
+    : _nodes{node_size, n_nodes}
+    , _wake{0U}
   {}
 
   Maid(const Maid&)            = delete;
@@ -97,50 +369,247 @@ public:
   Maid(Maid&&)                 = delete;
   Maid& operator=(Maid&&)      = delete;
 
-  ~Maid() { cleanup(); }
+  ~Maid()
+  {
+    stop_collector();
+    cleanup();
+
+    // Nothing can be protected any more, since hazards can't outlive us
+    Disposable* obj = _deferred.exchange(nullptr, std::memory_order_relaxed);
+    while (obj) {
+      Disposable* const next = obj->_maid_next.load(std::memory_order_relaxed);
+      delete obj;
+      obj = next;
+    }
+
+    for (HazardRecord* r = _hazards.load(std::memory_order_acquire); r;) {
+      HazardRecord* const next = r->next;
+      delete r;
+      r = next;
+    }
+  }
 
   /// Return false iff there is currently no garbage
   [[nodiscard]] bool empty() const
   {
-    return !_disposed.load(std::memory_order_relaxed);
+    if (_deferred.load(std::memory_order_relaxed)) {
+      return false;
+    }
+
+    for (const Shard& shard : _shards) {
+      if (!shard.empty()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+     Return statistics about garbage collection.
+
+     This may be called from any thread, and is lock-free, but the counters
+     are updated independently, so they may be slightly out of sync if
+     objects are being disposed or deleted at the same time.
+  */
+  [[nodiscard]] Stats stats() const
+  {
+    Stats stats{};
+
+    // Load the deleted count first, so it never exceeds the disposed count
+    stats.n_freed = _n_freed.load(std::memory_order_acquire);
+
+    const auto mean    = _mean_latency.load(std::memory_order_relaxed);
+    const auto max     = _max_latency.load(std::memory_order_relaxed);
+    size_t     n_bytes = 0U;
+
+    for (const Shard& shard : _shards) {
+      stats.n_disposed += shard._n_pushed.load(std::memory_order_relaxed);
+      n_bytes += shard._n_bytes.load(std::memory_order_relaxed);
+    }
+
+    stats.backlog      = stats.n_disposed - stats.n_freed;
+    stats.peak_backlog = std::max(
+      stats.backlog, _peak_backlog.load(std::memory_order_relaxed));
+
+    if (stats.n_disposed) {
+      const double mean_size = static_cast<double>(n_bytes) /
+                               static_cast<double>(stats.n_disposed);
+
+      stats.backlog_bytes =
+        static_cast<size_t>(mean_size * static_cast<double>(stats.backlog));
+    }
+
+    stats.max_latency  = std::chrono::nanoseconds{max};
+    stats.mean_latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double, std::nano>{mean});
+
+    return stats;
   }
 
   /**
      Enqueue an object for deletion when cleanup() is called next.
 
-     This is thread-safe, and real-time safe assuming reasonably low
-     contention.
+     This is thread-safe, wait-free, and real-time safe.
+
+     @param obj Object to delete.
+
+     @param size Estimated size of the object in bytes, which is only used
+     for statistics.
   */
-  void dispose(Disposable* obj)
+  void dispose(Disposable* obj, size_t size = 0U)
   {
     if (obj) {
-      // Atomically add obj to the head of the disposed list
-      do {
-        obj->_maid_next = _disposed.load(std::memory_order_relaxed);
-      } while (!_disposed.compare_exchange_weak(obj->_maid_next,
-                                                obj,
-                                                std::memory_order_release,
-                                                std::memory_order_relaxed));
+      const size_t n_pending = _shards[shard_index()].push(obj, size);
+      if (n_pending == _threshold.load(std::memory_order_relaxed)) {
+        _wake.post();
+      }
     }
   }
 
+  /**
+     Enqueue an object of any type for deletion when cleanup() is called
+     next.
+
+     The object is held by a node from the pool preallocated when the Maid
+     was created, so that it doesn't need to inherit from Disposable.  This
+     is thread-safe, lock-free, and real-time safe.
+
+     The object is deleted with `delete`, so it must not be an array
+     allocated with `new[]`, like an audio buffer.  Dispose of arrays as a
+     `std::unique_ptr<T[]>` instead, which deletes them with `delete[]`.
+
+     @return True on success, or false if there are no free nodes, in which
+     case the caller still owns `obj`.
+  */
+  template<class T,
+           class = std::enable_if_t<!std::is_base_of_v<Disposable, T>>>
+  [[nodiscard]] bool dispose(T* obj)
+  {
+    std::unique_ptr<T> owned{obj};
+    if (dispose(std::move(owned))) {
+      return true;
+    }
+
+    owned.release();
+    return false;
+  }
+
+  /**
+     Enqueue an owned object for deletion when cleanup() is called next.
+
+     This works like dispose(T*), but for objects with any deleter, and the
+     pointer is only moved from on success.  This is the way to dispose of
+     arrays, since `std::unique_ptr<T[]>` deletes them correctly.
+
+     @return True on success, or false if there are no free nodes.
+  */
+  template<class T, class Deleter>
+  [[nodiscard]] bool dispose(std::unique_ptr<T, Deleter>&& ptr)
+  {
+    using Ptr = std::unique_ptr<T, Deleter>;
+
+    static_assert(sizeof(Node<Ptr>) + alignof(std::max_align_t) <= node_size,
+                  "Deleter is too large for a Maid node");
+
+    if constexpr (std::is_base_of_v<Disposable, T> &&
+                  std::is_same_v<Deleter, std::default_delete<T>>) {
+      dispose(ptr.release(), sizeof(T));
+    } else if (ptr) {
+      Disposable* const node = new (_nodes) Node<Ptr>{std::move(ptr)};
+      if (!node) {
+        return false;
+      }
+
+      // The length of arrays is unknown, so only the node is counted
+      size_t size = sizeof(Node<Ptr>);
+      if constexpr (!std::is_array_v<T>) {
+        size += sizeof(T);
+      }
+
+      dispose(node, size);
+    }
+
+    return true;
+  }
+
   /**
      Delete all disposed objects immediately.
 
      Obviously not real-time safe, but may be called while other threads are
-     calling dispose().
+     calling dispose().  If another thread is already cleaning up, this
+     waits for it to finish first, so objects disposed before calling this
+     are deleted by the time it returns.
+
+     The exceptions are an object that is still being disposed while this
+     runs, and any object that is protected by a Hazard, which are left until
+     the next call.
   */
-  void cleanup()
+  void cleanup() { cleanup(SIZE_MAX); }
+
+  /**
+     Delete at most `max_objects` disposed objects immediately.
+
+     This is like cleanup(), but limits how long a single call can take.
+     Successive calls continue where the last one left off, so all threads
+     get their garbage deleted even if there's always more than the limit.
+
+     @return The number of objects deleted.
+  */
+  size_t cleanup(size_t max_objects)
   {
-    // Atomically get the head of the disposed list
-    const Disposable* const disposed =
-      _disposed.exchange(nullptr, std::memory_order_acquire);
+    const std::lock_guard<std::mutex> lock{_cleaning};
+    return clean(max_objects);
+  }
 
-    // Free the disposed list
-    for (const Disposable* obj = disposed; obj;) {
-      const Disposable* const next = obj->_maid_next;
-      delete obj;
-      obj = next;
+  /**
+     Try to delete at most `max_objects` disposed objects immediately.
+
+     This is like cleanup(), except if another thread is already cleaning
+     up, it returns zero immediately and leaves the work to that thread.  So,
+     unlike with cleanup(), objects disposed before calling this may not be
+     deleted yet when it returns.
+
+     @return The number of objects deleted.
+  */
+  size_t try_cleanup(size_t max_objects = SIZE_MAX)
+  {
+    const std::unique_lock<std::mutex> lock{_cleaning, std::try_to_lock};
+    return lock.owns_lock() ? clean(max_objects) : 0U;
+  }
+
+  /// Start a collector thread with default options
+  void start_collector() { start_collector(CollectorOptions{}); }
+
+  /**
+     Start a thread which calls cleanup() periodically.
+
+     If a collector is already running, it is stopped and replaced.  This,
+     and stop_collector(), must not be called concurrently.
+
+     @throw std::system_error if the thread can't be started.
+  */
+  void start_collector(const CollectorOptions& options)
+  {
+    stop_collector();
+    _collector = std::thread{[this, options] { collect(options); }};
+    _threshold.store(options.threshold, std::memory_order_relaxed);
+  }
+
+  /**
+     Stop the collector thread if it is running.
+
+     Garbage remaining when the collector stops is deleted by the next call
+     to cleanup(), or when the Maid is destroyed.
+  */
+  void stop_collector()
+  {
+    if (_collector.joinable()) {
+      _threshold.store(0U, std::memory_order_relaxed);
+      _stopping.store(true, std::memory_order_release);
+      _wake.post();
+      _collector.join();
+      _stopping.store(false, std::memory_order_relaxed);
     }
   }
 
@@ -152,13 +621,492 @@ public:
                                            Disposer<T>(this));
   }
 
+  /**
+     Make a shared pointer that will dispose its object when the last
+     reference is dropped.
+
+     The object and its reference count are allocated together, and are
+     deleted together by cleanup().
+  */
+  template<class T, class... Args>
+  managed_shared_ptr<T> make_managed_shared(Args&&... args)
+  {
+    auto* const object =
+      new SharedObject<T>(this, std::forward<Args>(args)...);
+
+    return managed_shared_ptr<T>{object->get(), object};
+  }
+
+  /**
+     Make a managed_ptr to an object allocated in an arena.
+
+     This is real-time safe (if the constructor is), so real-time code can
+     create short-lived managed objects.  When cleanup() deletes the object,
+     its memory is returned to the arena.  `T` must inherit from
+     Arena::Allocated.
+
+     @return A pointer to the new object, or null if the arena is exhausted.
+  */
+  template<class T, class... Args>
+  managed_ptr<T> make_managed_in(Arena& arena, Args&&... args)
+  {
+    return managed_ptr<T>(new (arena) T(std::forward<Args>(args)...),
+                          Disposer<T>(this));
+  }
+
 private:
-  std::atomic<Disposable*> _disposed;
+  /// Number of disposed lists, which should be at least the number of cores
+  static constexpr size_t n_shards = 16U;
+
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  /// The reference count of a shared object, disposed of along with it
+  class SharedCount : public Disposable
+  {
+  public:
+    SharedCount(Maid* maid, size_t size) noexcept
+      : _maid{maid}
+      , _size{size}
+    {}
+
+    void retain() noexcept { _n_refs.fetch_add(1U, std::memory_order_relaxed); }
+
+    void release() noexcept
+    {
+      if (_n_refs.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+        _maid->dispose(this, _size);
+      }
+    }
+
+    [[nodiscard]] size_t use_count() const noexcept
+    {
+      return _n_refs.load(std::memory_order_relaxed);
+    }
+
+  private:
+    Maid*               _maid;       ///< Maid that disposes of the object
+    size_t              _size;       ///< Size of the shared object
+    std::atomic<size_t> _n_refs{1U}; ///< Number of references
+  };
+
+  /// A shared object, allocated along with its reference count
+  template<class T>
+  class SharedObject final : public SharedCount
+  {
+  public:
+    template<class... Args>
+    explicit SharedObject(Maid* maid, Args&&... args)
+      : SharedCount{maid, sizeof(SharedObject)}
+      , _value(std::forward<Args>(args)...)
+    {}
+
+    T* get() noexcept { return &_value; }
+
+  private:
+    T _value;
+  };
+
+  /// Size of the blocks used for nodes, enough for small stateful deleters
+  static constexpr size_t node_size = 64U;
+
+  /// A node that holds an object that isn't Disposable
+  template<class Ptr>
+  class Node final
+    : public Disposable
+    , public Arena::Allocated
+  {
+  public:
+    explicit Node(Ptr&& ptr) noexcept
+      : _ptr{std::move(ptr)}
+    {}
+
+  private:
+    Ptr _ptr;
+  };
+
+  /**
+     A list of disposed objects.
+
+     This is an intrusive multi-producer single-consumer queue, as described
+     by Dmitry Vyukov, which uses `_maid_next` as the link.  Pushing is a
+     single exchange, so it is wait-free.  Objects are popped from the head,
+     which is only touched by cleanup(), and a stub node keeps the queue from
+     ever being empty, so that producers never need to touch the head.
+  */
+  struct Shard {
+    Shard()
+      : _tail{&_stub}
+      , _head{&_stub}
+    {}
+
+    Shard(const Shard&)            = delete;
+    Shard& operator=(const Shard&) = delete;
+    Shard(Shard&&)                 = delete;
+    Shard& operator=(Shard&&)      = delete;
+
+    ~Shard() = default;
+
+    [[nodiscard]] bool empty() const
+    {
+      return _tail.load(std::memory_order_acquire) == &_stub;
+    }
+
+    /// Push an object, and return the number of pending objects
+    size_t push(Disposable* obj, size_t size)
+    {
+      // Count first, so the count never drops below the length of the list
+      const size_t n_pending = _size.fetch_add(1U, std::memory_order_relaxed);
+
+      _n_pushed.fetch_add(1U, std::memory_order_relaxed);
+      if (size) {
+        _n_bytes.fetch_add(size, std::memory_order_relaxed);
+      }
+
+      link(obj);
+      return n_pending + 1U;
+    }
+
+    /// Note the number of objects pushed so far, at the time of a cleanup
+    void mark(TimePoint now)
+    {
+      const size_t n_pushed = _n_pushed.load(std::memory_order_relaxed);
+      if (!_n_marks && n_pushed == _n_taken) {
+        _since = now; // Nothing is pending, so anything new comes after now
+        return;
+      }
+
+      const size_t last = (_first_mark + _n_marks + n_marks - 1U) % n_marks;
+      if (_n_marks && n_pushed == _marks[last].n_pushed) {
+        return; // Nothing new since the last mark
+      }
+
+      if (_n_marks == n_marks) {
+        // Merge the oldest interval into the next, which only loses precision
+        _first_mark = (_first_mark + 1U) % n_marks;
+        --_n_marks;
+      }
+
+      _marks[(_first_mark + _n_marks) % n_marks] = {now, n_pushed};
+      ++_n_marks;
+    }
+
+    /// Return the latest time the last object taken could have been pushed
+    [[nodiscard]] TimePoint marked(TimePoint now) const
+    {
+      return _n_marks ? _marks[_first_mark].time : now;
+    }
+
+    /// Pop the oldest object, and count it as no longer pending
+    Disposable* take()
+    {
+      Disposable* const obj = pop();
+      if (obj) {
+        _size.fetch_sub(1U, std::memory_order_relaxed);
+
+        // Skip marks made before this object was pushed
+        while (_n_marks && _n_taken >= _marks[_first_mark].n_pushed) {
+          _since      = _marks[_first_mark].time;
+          _first_mark = (_first_mark + 1U) % n_marks;
+          --_n_marks;
+        }
+
+        ++_n_taken;
+      }
+
+      return obj;
+    }
+
+    /// Append an object to the tail of the list
+    void link(Disposable* obj)
+    {
+      obj->_maid_next.store(nullptr, std::memory_order_relaxed);
+
+      Disposable* const prev = _tail.exchange(obj, std::memory_order_acq_rel);
+      prev->_maid_next.store(obj, std::memory_order_release);
+    }
+
+    /// Pop the oldest object, or return null if there is none (yet)
+    Disposable* pop()
+    {
+      Disposable* head = _head;
+      Disposable* next = head->_maid_next.load(std::memory_order_acquire);
+      if (head == &_stub) {
+        if (!next) {
+          return nullptr; // Empty
+        }
+
+        // Skip the stub
+        _head = next;
+        head  = next;
+        next  = next->_maid_next.load(std::memory_order_acquire);
+      }
+
+      if (next) {
+        _head = next;
+        return head;
+      }
+
+      if (head != _tail.load(std::memory_order_acquire)) {
+        return nullptr; // A push is in progress, so the list is incomplete
+      }
+
+      // Head is the last object, so push the stub after it to pop it
+      link(&_stub);
+      next = head->_maid_next.load(std::memory_order_acquire);
+      if (next) {
+        _head = next;
+        return head;
+      }
+
+      return nullptr;
+    }
+
+    /// Last object pushed, written by any thread that disposes
+    alignas(detail::cache_line_size) std::atomic<Disposable*> _tail;
+
+    /// Number of objects pushed and not yet taken
+    std::atomic<size_t> _size{0U};
+
+    std::atomic<size_t> _n_pushed{0U}; ///< Total number of objects pushed
+    std::atomic<size_t> _n_bytes{0U};  ///< Total size of objects pushed
+
+    /// Next object to pop, only used by cleanup()
+    alignas(detail::cache_line_size) Disposable* _head;
+
+    /// Number of marks kept, beyond which the oldest are merged
+    static constexpr size_t n_marks = 8U;
+
+    /// The number of objects pushed when cleanup() ran at some time
+    struct Mark {
+      TimePoint time;     ///< Time of the cleanup
+      size_t    n_pushed; ///< Number of objects pushed by then
+    };
+
+    // Marks of objects not yet taken, only used by cleanup()
+    Mark   _marks[n_marks]{}; ///< Ring of marks, oldest first
+    size_t _first_mark{0U};   ///< Index of the oldest mark
+    size_t _n_marks{0U};      ///< Number of marks
+    size_t _n_taken{0U};      ///< Total number of objects taken
+
+    /// Time before which the next object to take was not yet pushed
+    TimePoint _since{std::chrono::steady_clock::now()};
+
+    /// Placeholder that is in the list when it is otherwise empty
+    Disposable _stub;
+  };
+
+  /**
+     Return the index of the shard used by the calling thread.
+
+     This hashes the thread ID rather than using a thread_local index,
+     since thread-local storage in a dynamically loaded library may be
+     allocated on first use, which isn't real-time safe.
+  */
+  static size_t shard_index()
+  {
+    return std::hash<std::thread::id>{}(std::this_thread::get_id()) %
+           n_shards;
+  }
+
+  /// A hazard pointer slot, which is reused once its Hazard is destroyed
+  struct HazardRecord {
+    /// Protected object, written by the reader
+    alignas(detail::cache_line_size)
+      std::atomic<const Disposable*> ptr{nullptr};
+
+    std::atomic<bool> in_use{true}; ///< True if owned by a Hazard
+    HazardRecord*     next{nullptr}; ///< Next record, constant once added
+  };
+
+  /// Claim a free hazard record, or allocate a new one
+  HazardRecord* acquire_hazard()
+  {
+    for (HazardRecord* r = _hazards.load(std::memory_order_acquire); r;
+         r = r->next) {
+      bool expected = false;
+      if (!r->in_use.load(std::memory_order_relaxed) &&
+          r->in_use.compare_exchange_strong(expected,
+                                            true,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+        return r;
+      }
+    }
+
+    auto* const record = new HazardRecord{};
+    record->next       = _hazards.load(std::memory_order_relaxed);
+    while (!_hazards.compare_exchange_weak(record->next,
+                                           record,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+
+    return record;
+  }
+
+  /// Return true if an object is protected by any hazard
+  [[nodiscard]] bool is_protected(const Disposable* obj) const
+  {
+    // Pair with the fence in Hazard::protect()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    for (const HazardRecord* r = _hazards.load(std::memory_order_acquire); r;
+         r = r->next) {
+      if (r->ptr.load(std::memory_order_acquire) == obj) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /// Delete an object and return true, or defer it if it's protected
+  bool release(Disposable* obj)
+  {
+    if (is_protected(obj)) {
+      obj->_maid_next.store(_deferred.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+      _deferred.store(obj, std::memory_order_relaxed);
+      return false;
+    }
+
+    delete obj;
+
+    // Release so that stats() sees at least as many objects disposed
+    _n_freed.fetch_add(1U, std::memory_order_release);
+    return true;
+  }
+
+  /**
+     Record the latency of an object deleted by cleanup().
+
+     @param now Time of the cleanup.
+     @param since Earliest time the object could have been disposed.
+     @param until Latest time the object could have been disposed.
+  */
+  void record_latency(TimePoint now, TimePoint since, TimePoint until)
+  {
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+
+    const TimePoint mid     = since + ((until - since) / 2);
+    const double    latency = Nanoseconds{now - mid}.count();
+    const double    mean    = _mean_latency.load(std::memory_order_relaxed);
+
+    // Keep a running mean, which can't overflow like a total
+    ++_n_timed;
+    _mean_latency.store(
+      mean + ((latency - mean) / static_cast<double>(_n_timed)),
+      std::memory_order_relaxed);
+
+    const int64_t max =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - since)
+        .count();
+    if (max > _max_latency.load(std::memory_order_relaxed)) {
+      _max_latency.store(max, std::memory_order_relaxed);
+    }
+  }
+
+  /// Delete at most `max_objects` objects, with `_cleaning` held
+  size_t clean(size_t max_objects)
+  {
+    // The backlog only shrinks while cleaning, so this catches the peak
+    update_peak_backlog();
+
+    // Objects are timed by when their list was marked, see Stats
+    const TimePoint now = std::chrono::steady_clock::now();
+
+    // Retry objects that were protected last time (at most one per hazard)
+    size_t      n_deleted = 0U;
+    Disposable* deferred  = _deferred.exchange(nullptr,
+                                               std::memory_order_relaxed);
+    while (deferred) {
+      Disposable* const next =
+        deferred->_maid_next.load(std::memory_order_relaxed);
+
+      n_deleted += release(deferred) ? 1U : 0U;
+      deferred = next;
+    }
+
+    for (size_t i = 0U; i < n_shards; ++i) {
+      Shard& shard = _shards[_next_shard];
+      shard.mark(now);
+      while (n_deleted < max_objects) {
+        Disposable* const obj = shard.take();
+        if (!obj) {
+          break;
+        }
+
+        if (release(obj)) {
+          record_latency(now, shard._since, shard.marked(now));
+          ++n_deleted;
+        }
+      }
+
+      if (n_deleted >= max_objects) {
+        break;
+      }
+
+      _next_shard = (_next_shard + 1U) % n_shards;
+    }
+
+    return n_deleted;
+  }
+
+  /// Update the peak backlog, which is only written by cleanup()
+  void update_peak_backlog()
+  {
+    const size_t n_freed    = _n_freed.load(std::memory_order_relaxed);
+    size_t       n_disposed = 0U;
+    for (const Shard& shard : _shards) {
+      n_disposed += shard._n_pushed.load(std::memory_order_relaxed);
+    }
+
+    const size_t backlog = n_disposed - n_freed;
+    if (backlog > _peak_backlog.load(std::memory_order_relaxed)) {
+      _peak_backlog.store(backlog, std::memory_order_relaxed);
+    }
+  }
+
+  /// Main loop of the collector thread
+  void collect(const CollectorOptions& options)
+  {
+    while (!_stopping.load(std::memory_order_acquire)) {
+      _wake.timed_wait(options.period);
+      if (!_stopping.load(std::memory_order_acquire)) {
+        try_cleanup(options.batch_size);
+      }
+    }
+  }
+
+  Shard                    _shards[n_shards];  ///< Disposed lists
+  std::mutex               _cleaning;          ///< Held while cleaning
+  size_t                   _next_shard{0U};    ///< Next list to clean
+  std::atomic<Disposable*> _deferred{nullptr}; ///< Protected objects
+
+  std::atomic<HazardRecord*> _hazards{nullptr}; ///< Hazard records
+
+  Arena _nodes; ///< Nodes for disposing objects of any type
+
+  /// Number of objects deleted, the first statistic written by cleanup()
+  alignas(detail::cache_line_size) std::atomic<size_t> _n_freed{0U};
+
+  std::atomic<size_t>  _peak_backlog{0U};  ///< Largest backlog seen
+  std::atomic<double>  _mean_latency{0.0}; ///< Mean latency in nanoseconds
+  std::atomic<int64_t> _max_latency{0};    ///< Maximum latency in nanoseconds
+  size_t               _n_timed{0U};       ///< Number of objects timed
+
+  std::atomic<size_t> _threshold{0U};   ///< Collector threshold
+  std::atomic<bool>   _stopping{false}; ///< Stops the collector
+  Semaphore           _wake;            ///< Wakes the collector
+  std::thread         _collector;       ///< Collector thread
 };
 
 template<typename T>
 using managed_ptr = Maid::managed_ptr<T>;
 
+template<typename T>
+using managed_shared_ptr = Maid::managed_shared_ptr<T>;
+
 } // namespace raul
 
 #endif // RAUL_MAID_HPP
@@ -0,0 +1,213 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_MIRROREDRINGBUFFER_HPP
+#define RAUL_MIRROREDRINGBUFFER_HPP
+
+#include <raul/RingBuffer.hpp>
+#include <raul/detail/FreeRunningRing.hpp>
+#include <raul/detail/Util.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#ifndef __linux__
+#  include <cstdio>
+#endif
+
+namespace raul {
+
+/**
+   A lock-free RingBuffer with a mirrored memory mapping.
+
+   The storage is mapped twice in a row in virtual memory, so the byte after
+   the end of the buffer is the first byte of the buffer again.  This means
+   that any region of the buffer is contiguous, so reading and writing never
+   need to split around the end, and the vectors returned by write_vector()
+   and read_vector() always have an empty second segment.
+
+   Reading and writing works like RingBuffer, but there is no consume(),
+   since read_vector() is already contiguous, and no statistics.  The size
+   is rounded up to at least the page size, and free-running heads are used,
+   so the capacity is the full size rather than one byte less.  The buffer
+   can't be moved.
+
+   Thread-safe with a single reader and single writer, and real-time safe
+   on both ends.
+
+   @ingroup raul
+*/
+class MirroredRingBuffer
+{
+public:
+  using WriteVector = RingBuffer::WriteVector; ///< Writable space
+  using ReadVector  = RingBuffer::ReadVector;  ///< Readable data
+
+  /**
+     Create a new MirroredRingBuffer.
+
+     @param size Size in bytes (note this may be rounded up).
+     @throw std::length_error if the size is larger than 2 GiB.
+     @throw std::runtime_error if the memory mapping fails.
+  */
+  explicit MirroredRingBuffer(uint32_t size)
+    : _size(ring_size(size))
+    , _buf(map_mirrored(_size))
+    , _ring{_heads, _buf, _size}
+  {
+    assert(read_space() == 0);
+    assert(write_space() == _size);
+  }
+
+  MirroredRingBuffer(const MirroredRingBuffer&)            = delete;
+  MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+  MirroredRingBuffer(MirroredRingBuffer&&)                 = delete;
+  MirroredRingBuffer& operator=(MirroredRingBuffer&&)      = delete;
+
+  ~MirroredRingBuffer() { munmap(_buf, size_t{_size} * 2U); }
+
+  /**
+     Reset (empty) the ring.
+
+     This method is NOT thread-safe, it may only be called when there are no
+     readers or writers.
+  */
+  void reset() { _ring.reset(); }
+
+  /// Return the number of bytes of space available for reading
+  [[nodiscard]] uint32_t read_space() const { return _ring.read_space(); }
+
+  /// Return the number of bytes of space available for writing
+  [[nodiscard]] uint32_t write_space() const { return _ring.write_space(); }
+
+  /// Return the capacity (i.e. total write space when empty)
+  [[nodiscard]] uint32_t capacity() const { return _size; }
+
+  /// Read from the ring without advancing the read head
+  uint32_t peek(uint32_t size, void* dst) { return _ring.peek(size, dst); }
+
+  /// Read from the ring and advance the read head
+  uint32_t read(uint32_t size, void* dst) { return _ring.read(size, dst); }
+
+  /// Skip data in the ring (advance read head without reading)
+  uint32_t skip(uint32_t size) { return _ring.skip(size); }
+
+  /// Write data to the ring
+  uint32_t write(uint32_t size, const void* src)
+  {
+    return _ring.write(size, src);
+  }
+
+  /// Return all space currently available for writing, as a single segment
+  WriteVector write_vector() { return _ring.write_vector(); }
+
+  /// Advance the write head after writing to a write_vector()
+  void commit_write(uint32_t size) { _ring.commit_write(size); }
+
+  /// Return all data currently available for reading, as a single segment
+  ReadVector read_vector() { return _ring.read_vector(); }
+
+  /// Advance the read head after reading from a read_vector()
+  void commit_read(uint32_t size) { _ring.commit_read(size); }
+
+private:
+  using Ring = detail::FreeRunningRing<uint32_t, true>;
+
+  static uint32_t page_size()
+  {
+    return static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+  }
+
+  /// Return the size of the buffer for a requested size
+  static uint32_t ring_size(uint32_t size)
+  {
+    // The largest power of two, so free-running head differences never wrap
+    constexpr uint32_t max_size = 1U << 31U;
+
+    if (size > max_size) {
+      throw std::length_error("Ring buffer size is too large");
+    }
+
+    return detail::next_power_of_two(std::max(size, page_size()));
+  }
+
+  /// Create an anonymous shared memory file
+  static int create_file()
+  {
+#ifdef __linux__
+    return memfd_create("raul-ring", MFD_CLOEXEC);
+#else
+    // Create a uniquely named object, then immediately unlink it
+    static std::atomic<unsigned> counter{0U};
+
+    char name[64] = {};
+    snprintf(name,
+             sizeof(name),
+             "/raul-ring-%ld-%u",
+             static_cast<long>(getpid()),
+             counter++);
+
+    const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+      shm_unlink(name);
+    }
+
+    return fd;
+#endif
+  }
+
+  /// Map a file of `size` bytes twice in a row and return the start
+  static char* map_mirrored(uint32_t size)
+  {
+    const int fd = create_file();
+    if (fd < 0) {
+      throw std::runtime_error("Failed to create ring buffer memory");
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size))) {
+      close(fd);
+      throw std::runtime_error("Failed to size ring buffer memory");
+    }
+
+    // Reserve enough address space for both mappings
+    const size_t total = size_t{size} * 2U;
+    void* const  base =
+      mmap(nullptr, total, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Failed to reserve ring buffer memory");
+    }
+
+    // Map the file into both halves of the reserved space
+    char* const first  = static_cast<char*>(base);
+    char* const second = first + size;
+    const int   prot   = PROT_READ | PROT_WRITE;
+    const int   flags  = MAP_SHARED | MAP_FIXED;
+    if (mmap(first, size, prot, flags, fd, 0) == MAP_FAILED ||
+        mmap(second, size, prot, flags, fd, 0) == MAP_FAILED) {
+      munmap(base, total);
+      close(fd);
+      throw std::runtime_error("Failed to map ring buffer memory");
+    }
+
+    close(fd);
+    return first;
+  }
+
+  uint32_t    _size;  ///< Size (capacity) in bytes
+  char*       _buf;   ///< Start of the first of two mappings
+  Ring::Heads _heads; ///< Read and write heads
+  Ring        _ring;  ///< Reader and writer
+};
+
+} // namespace raul
+
+#endif // RAUL_MIRROREDRINGBUFFER_HPP
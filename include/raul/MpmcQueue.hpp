@@ -0,0 +1,269 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_MPMCQUEUE_HPP
+#define RAUL_MPMCQUEUE_HPP
+
+#include <raul/detail/Util.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace raul {
+
+/**
+   A bounded lock-free queue with several writers and several readers.
+
+   Every slot in the queue has a sequence number which says whether it is
+   ready to be written or read in the current lap around the queue.  A thread
+   claims slots by advancing the shared write or read position with a
+   compare-and-swap, then only touches the slots it owns, so threads never
+   wait for each other except to retry a failed claim.  The batch operations
+   claim several adjacent slots at once with a single compare-and-swap.
+
+   Thread-safe with any number of readers and writers, and real-time safe on
+   both ends assuming reasonably low contention (no operation allocates or
+   blocks).
+
+   @ingroup raul
+*/
+template<class T>
+class MpmcQueue
+{
+public:
+  static_assert(std::is_nothrow_move_constructible_v<T>);
+  static_assert(std::is_nothrow_destructible_v<T>);
+  static_assert(std::is_nothrow_move_assignable_v<T>);
+
+  /**
+     Create a new MpmcQueue.
+
+     @param capacity Maximum number of elements (note this may be rounded up).
+  */
+  explicit MpmcQueue(size_t capacity)
+    : _capacity(detail::next_power_of_two(capacity < 2U ? 2U : capacity))
+    , _mask(_capacity - 1U)
+    , _cells(new Cell[_capacity])
+  {
+    for (size_t i = 0U; i < _capacity; ++i) {
+      _cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcQueue(const MpmcQueue&)            = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+  MpmcQueue(MpmcQueue&&)                 = delete;
+  MpmcQueue& operator=(MpmcQueue&&)      = delete;
+
+  ~MpmcQueue()
+  {
+    const size_t end = _enqueue_pos.load(std::memory_order_relaxed);
+    for (size_t pos = _dequeue_pos.load(std::memory_order_relaxed); pos != end;
+         ++pos) {
+      _cells[pos & _mask].value()->~T();
+    }
+  }
+
+  /// Return the maximum number of elements the queue can hold
+  [[nodiscard]] size_t capacity() const { return _capacity; }
+
+  /// Return the number of elements in the queue (only a hint if in use)
+  [[nodiscard]] size_t size() const
+  {
+    const size_t r = _dequeue_pos.load(std::memory_order_relaxed);
+    const size_t w = _enqueue_pos.load(std::memory_order_relaxed);
+    return w - r > _capacity ? 0U : w - r;
+  }
+
+  /// Push an element, return false if the queue is full
+  bool try_push(T&& value) { return try_push_n(&value, 1U) == 1U; }
+
+  /// Push a copy of an element, return false if the queue is full
+  bool try_push(const T& value) { return try_push(T(value)); }
+
+  /**
+     Construct an element in place, return false if the queue is full.
+
+     If the constructor can't throw, the element is constructed directly in
+     the queue, and nothing is constructed if the queue is full.  Otherwise,
+     the element is constructed first and then moved in, since once a slot
+     is claimed it must be filled.
+  */
+  template<class... Args>
+  bool try_emplace(Args&&... args)
+  {
+    if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+      size_t pos = 0U;
+      if (!claim_push(1U, pos)) {
+        return false;
+      }
+
+      Cell& cell = _cells[pos & _mask];
+      new (cell.storage) T(std::forward<Args>(args)...);
+      cell.seq.store(pos + 1U, std::memory_order_release);
+      return true;
+    } else {
+      return try_push(T(std::forward<Args>(args)...));
+    }
+  }
+
+  /**
+     Push several elements.
+
+     The elements are claimed as a contiguous block, so they are read in order
+     even if other threads are also pushing.
+
+     @param values Array of elements to move into the queue.
+     @param count Number of elements in `values`.
+     @return The number of elements pushed, which may be less than `count` if
+     the queue doesn't have enough space.  Only those elements are moved
+     from.
+  */
+  size_t try_push_n(T* values, size_t count)
+  {
+    size_t       pos = 0U;
+    const size_t n   = claim_push(count, pos);
+    for (size_t i = 0U; i < n; ++i) {
+      Cell& cell = _cells[(pos + i) & _mask];
+      new (cell.storage) T(std::move(values[i]));
+      cell.seq.store(pos + i + 1U, std::memory_order_release);
+    }
+
+    return n;
+  }
+
+  /// Pop an element, return false if the queue is empty
+  bool try_pop(T& value) { return try_pop_n(&value, 1U) == 1U; }
+
+  /**
+     Pop several elements.
+
+     @param values Array to move popped elements into.
+     @param count Maximum number of elements to pop.
+     @return The number of elements popped.
+  */
+  size_t try_pop_n(T* values, size_t count)
+  {
+    if (!count) {
+      return 0U;
+    }
+
+    size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    size_t n   = 0U;
+    for (;;) {
+      // Count the full cells starting at pos
+      for (n = 0U; n < count; ++n) {
+        if (cell_lag(pos + n, pos + n + 1U) != 0) {
+          break;
+        }
+      }
+
+      if (!n && cell_lag(pos, pos + 1U) < 0) {
+        return 0U; // Empty
+      }
+
+      if (n && _dequeue_pos.compare_exchange_weak(pos,
+                                                  pos + n,
+                                                  std::memory_order_relaxed,
+                                                  std::memory_order_relaxed)) {
+        break;
+      }
+
+      if (!n) {
+        pos = _dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    for (size_t i = 0U; i < n; ++i) {
+      Cell& cell  = _cells[(pos + i) & _mask];
+      T*    value = cell.value();
+      values[i]   = std::move(*value);
+      value->~T();
+      cell.seq.store(pos + i + _capacity, std::memory_order_release);
+    }
+
+    return n;
+  }
+
+private:
+  /**
+     Claim up to `count` adjacent free cells for pushing.
+
+     @param count Maximum number of cells to claim.
+     @param pos Set to the position of the first claimed cell.
+     @return The number of cells claimed, which must all be filled.
+  */
+  size_t claim_push(size_t count, size_t& pos)
+  {
+    if (!count) {
+      return 0U;
+    }
+
+    pos = _enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+      // Count the free cells starting at pos
+      size_t n = 0U;
+      for (; n < count; ++n) {
+        if (cell_lag(pos + n, pos + n) != 0) {
+          break;
+        }
+      }
+
+      if (!n && cell_lag(pos, pos) < 0) {
+        return 0U; // Full
+      }
+
+      if (n && _enqueue_pos.compare_exchange_weak(pos,
+                                                  pos + n,
+                                                  std::memory_order_relaxed,
+                                                  std::memory_order_relaxed)) {
+        return n;
+      }
+
+      if (!n) {
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  struct Cell {
+    T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+    std::atomic<size_t>  seq;                ///< Position cell is ready for
+    alignas(T) std::byte storage[sizeof(T)]; ///< Element, if pushed
+  };
+
+  /**
+     Return how far the sequence number of the cell at `pos` is from `seq`.
+
+     Zero means the cell is ready, negative means it is still a lap behind
+     (full when pushing, empty when popping), and positive means another
+     thread has already claimed `pos`.
+  */
+  ptrdiff_t cell_lag(size_t pos, size_t seq) const
+  {
+    const size_t cell_seq = _cells[pos & _mask].seq.load(
+      std::memory_order_acquire);
+
+    return static_cast<ptrdiff_t>(cell_seq - seq);
+  }
+
+  // Shared and constant after construction
+  size_t                  _capacity; ///< Number of cells
+  size_t                  _mask;     ///< Mask for fast modulo
+  std::unique_ptr<Cell[]> _cells;    ///< Contents
+
+  /// Position of the next cell to push to, shared by all writers
+  alignas(detail::cache_line_size) std::atomic<size_t> _enqueue_pos{};
+
+  /// Position of the next cell to pop from, shared by all readers
+  alignas(detail::cache_line_size) std::atomic<size_t> _dequeue_pos{};
+};
+
+} // namespace raul
+
+#endif // RAUL_MPMCQUEUE_HPP
@@ -0,0 +1,255 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_MPSCRINGBUFFER_HPP
+#define RAUL_MPSCRINGBUFFER_HPP
+
+#include <raul/detail/Util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace raul {
+
+/**
+   A lock-free ring buffer of messages with several writers.
+
+   Unlike RingBuffer, this is message-oriented: each write() is an indivisible
+   message, and each read() returns exactly one complete message.  Any number
+   of threads may write concurrently, but only a single thread may read.
+
+   Writers reserve space with a compare-and-swap, copy their message, then
+   mark it as complete.  The reader never waits: if the next message is still
+   being written, it simply appears empty until the writer is finished (so a
+   writer which is preempted in the middle of a write delays later messages,
+   but never blocks the reader).
+
+   The reader is wait-free and real-time safe.  Writers are lock-free, and
+   real-time safe assuming reasonably low contention.
+
+   @ingroup raul
+*/
+class MpscRingBuffer
+{
+public:
+  /**
+     Create a new MpscRingBuffer.
+
+     @param size Size in bytes (note this may be rounded up).
+     @throw std::length_error if the size is larger than 2 GiB.
+     @throw std::bad_alloc if the contents can't be allocated.
+  */
+  explicit MpscRingBuffer(uint32_t size)
+    : _size(ring_size(size))
+    , _size_mask(_size - 1U)
+    , _buf(new char[_size])
+    , _marks(new std::atomic<uint32_t>[_size / granule]())
+  {}
+
+  MpscRingBuffer(const MpscRingBuffer&)            = delete;
+  MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+  MpscRingBuffer(MpscRingBuffer&&)                 = delete;
+  MpscRingBuffer& operator=(MpscRingBuffer&&)      = delete;
+
+  ~MpscRingBuffer() = default;
+
+  /**
+     Reset (empty) the ring.
+
+     This method is NOT thread-safe, it may only be called when there are no
+     readers or writers.
+  */
+  void reset()
+  {
+    for (uint32_t i = 0U; i < _size / granule; ++i) {
+      _marks[i].store(0U, std::memory_order_relaxed);
+    }
+
+    _write_head.store(0U, std::memory_order_relaxed);
+    _read_head.store(0U, std::memory_order_relaxed);
+  }
+
+  /**
+     Return the number of bytes of space available for writing.
+
+     This is only a hint, since other writers may use the space at any time.
+     Messages are padded to a multiple of 8 bytes, so the largest message
+     that fits may be slightly smaller.
+  */
+  [[nodiscard]] uint32_t write_space() const
+  {
+    const uint32_t r = _read_head.load(std::memory_order_acquire);
+    const uint32_t w = _write_head.load(std::memory_order_relaxed);
+    return _size - (w - r);
+  }
+
+  /// Return the capacity (i.e. total write space when empty)
+  [[nodiscard]] uint32_t capacity() const { return _size; }
+
+  /// Return the size of the next complete message, or zero if there is none
+  [[nodiscard]] uint32_t peek_size() const
+  {
+    return _marks[slot(_read_head.load(std::memory_order_relaxed))].load(
+      std::memory_order_acquire);
+  }
+
+  /**
+     Read the next message without consuming it.
+
+     @param size Size of `dst` in bytes.
+     @param dst Buffer to copy the message into.
+     @return The size of the message, or zero if there is no complete message
+     or it is larger than `size`.
+  */
+  uint32_t peek(uint32_t size, void* dst) const
+  {
+    const uint32_t r        = _read_head.load(std::memory_order_relaxed);
+    const uint32_t msg_size = _marks[slot(r)].load(std::memory_order_acquire);
+    if (!msg_size || msg_size > size) {
+      return 0U;
+    }
+
+    const uint32_t offset     = r & _size_mask;
+    const uint32_t first_size = std::min(msg_size, _size - offset);
+    memcpy(dst, &_buf[offset], first_size);
+    memcpy(static_cast<char*>(dst) + first_size,
+           &_buf[0],
+           msg_size - first_size);
+
+    return msg_size;
+  }
+
+  /**
+     Read the next message and advance the read head.
+
+     @param size Size of `dst` in bytes.
+     @param dst Buffer to copy the message into.
+     @return The size of the message, or zero if there is no complete message
+     or it is larger than `size` (in which case it is left in the buffer).
+  */
+  uint32_t read(uint32_t size, void* dst)
+  {
+    const uint32_t msg_size = peek(size, dst);
+    if (msg_size) {
+      consume(msg_size);
+    }
+
+    return msg_size;
+  }
+
+  /// Skip the next message, return its size or zero if there is none
+  uint32_t skip()
+  {
+    const uint32_t msg_size = peek_size();
+    if (msg_size) {
+      consume(msg_size);
+    }
+
+    return msg_size;
+  }
+
+  /**
+     Write a message.
+
+     This may be called by several threads concurrently.
+
+     @param size Size of the message in bytes, which must be at least 1.
+     @param src Message to copy into the buffer.
+     @return `size` on success, or zero if there is not enough space.
+  */
+  uint32_t write(uint32_t size, const void* src)
+  {
+    const uint32_t total = padded_size(size);
+    if (!size || total > _size || total < size) {
+      return 0U;
+    }
+
+    // Reserve space by advancing the write head past the message
+    uint32_t w = _write_head.load(std::memory_order_relaxed);
+    for (;;) {
+      const uint32_t r = _read_head.load(std::memory_order_acquire);
+      if (static_cast<int32_t>(w - r) < 0) {
+        // Other writers and the reader have moved past w, so it's stale
+        w = _write_head.load(std::memory_order_relaxed);
+        continue;
+      }
+
+      if (w - r > _size - total) {
+        return 0U;
+      }
+
+      if (_write_head.compare_exchange_weak(w,
+                                            w + total,
+                                            std::memory_order_relaxed,
+                                            std::memory_order_relaxed)) {
+        break;
+      }
+    }
+
+    // Copy the message into the reserved space
+    const uint32_t offset     = w & _size_mask;
+    const uint32_t first_size = std::min(size, _size - offset);
+    memcpy(&_buf[offset], src, first_size);
+    memcpy(
+      &_buf[0], static_cast<const char*>(src) + first_size, size - first_size);
+
+    // Mark the message as complete so the reader can see it
+    _marks[slot(w)].store(size, std::memory_order_release);
+    return size;
+  }
+
+private:
+  /// Granularity of message positions in the buffer
+  static constexpr uint32_t granule = 8U;
+
+  /// Maximum size, so that free-running head differences never overflow
+  static constexpr uint32_t max_size = 1U << 31U;
+
+  /// Return the size of the buffer for a requested size
+  static uint32_t ring_size(uint32_t size)
+  {
+    if (size > max_size) {
+      throw std::length_error("Ring buffer size is too large");
+    }
+
+    return detail::next_power_of_two(std::max(size, granule));
+  }
+
+  static uint32_t padded_size(uint32_t size)
+  {
+    return (size + granule - 1U) & ~(granule - 1U);
+  }
+
+  [[nodiscard]] uint32_t slot(uint32_t head) const
+  {
+    return (head & _size_mask) / granule;
+  }
+
+  void consume(uint32_t msg_size)
+  {
+    const uint32_t r = _read_head.load(std::memory_order_relaxed);
+    _marks[slot(r)].store(0U, std::memory_order_relaxed);
+    _read_head.store(r + padded_size(msg_size), std::memory_order_release);
+  }
+
+  // Shared and constant after construction
+  uint32_t                                 _size;      ///< Size in bytes
+  uint32_t                                 _size_mask; ///< Mask for modulo
+  std::unique_ptr<char[]>                  _buf;       ///< Contents
+  std::unique_ptr<std::atomic<uint32_t>[]> _marks;     ///< Message sizes
+
+  /// Free-running write position, shared by all writers
+  alignas(detail::cache_line_size) std::atomic<uint32_t> _write_head{};
+
+  /// Free-running read position, written only by the reader
+  alignas(detail::cache_line_size) std::atomic<uint32_t> _read_head{};
+};
+
+} // namespace raul
+
+#endif // RAUL_MPSCRINGBUFFER_HPP
@@ -0,0 +1,242 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_RECORDRING_HPP
+#define RAUL_RECORDRING_HPP
+
+#include <raul/RingBuffer.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace raul {
+
+/**
+   A lock-free ring of variable-length records.
+
+   Each record is a header with a type and size, followed by a body.  A record
+   is written with a single commit, so the reader never sees a header without
+   its body.  Records are never split around the end of the buffer, so the
+   body of a record can always be accessed in place as a single contiguous
+   (and 8-byte aligned) region.  This means that a record must fit in half
+   of the buffer to be sure to fit wherever the heads are, so larger records
+   are rejected (see max_size()).
+
+   Thread-safe with a single reader and single writer, and real-time safe
+   on both ends.
+
+   @ingroup raul
+*/
+class RecordRing
+{
+public:
+  /// The header at the start of every record
+  struct Header {
+    uint32_t type; ///< Record type (any value except padding_type)
+    uint32_t size; ///< Size of the record body in bytes
+  };
+
+  /// Reserved record type used internally to pad to the end of the buffer
+  static constexpr uint32_t padding_type = UINT32_MAX;
+
+  /**
+     Create a new RecordRing.
+
+     @param size Size in bytes (note this may be rounded up).
+  */
+  explicit RecordRing(uint32_t size)
+    : _ring(size < 2U * record_alignment ? 2U * record_alignment : size)
+  {}
+
+  /**
+     Reset (empty) the ring.
+
+     This method is NOT thread-safe, it may only be called when there are no
+     readers or writers.
+  */
+  void reset() { _ring.reset(); }
+
+  /**
+     Return the largest record body size that can be written.
+
+     This is about half of the buffer, since a record has to fit entirely
+     before or after the write head, which may be anywhere.
+  */
+  [[nodiscard]] uint32_t max_size() const
+  {
+    return ((_ring.capacity() + 1U) / 2U) - uint32_t{sizeof(Header)};
+  }
+
+  /**
+     Write a record.
+
+     @param type Record type, which must not be padding_type.
+     @param size Size of `body` in bytes.
+     @param body Record body.
+     @return True on success, or false if there is not enough space, or the
+     record is larger than max_size().
+  */
+  bool write(uint32_t type, uint32_t size, const void* body)
+  {
+    if (size > max_size()) {
+      return false;
+    }
+
+    const uint32_t total = record_size(size);
+
+    const RingBuffer::WriteVector vec = _ring.write_vector();
+    if (vec.first.size >= total) {
+      // Record fits before the end of the buffer
+      write_record(vec.first.data, type, size, body);
+      _ring.commit_write(total);
+      return true;
+    }
+
+    if (vec.second.size >= total) {
+      // Pad to the end of the buffer and write the record at the start
+      const uint32_t pad_size = vec.first.size - uint32_t{sizeof(Header)};
+      write_record(vec.first.data, padding_type, pad_size, nullptr);
+      write_record(vec.second.data, type, size, body);
+      _ring.commit_write(vec.first.size + total);
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+     Access the next record without consuming it.
+
+     @param header Set to the header of the next record on success.
+     @return A pointer to the body of the next record, or null if the ring is
+     empty.  This remains valid until the record is read or skipped.
+  */
+  const void* peek(Header& header)
+  {
+    for (;;) {
+      const RingBuffer::ReadVector vec = _ring.read_vector();
+      if (vec.first.size < sizeof(Header)) {
+        return nullptr;
+      }
+
+      memcpy(&header, vec.first.data, sizeof(Header));
+      if (header.type != padding_type) {
+        return vec.first.data + sizeof(Header);
+      }
+
+      _ring.commit_read(record_size(header.size));
+    }
+  }
+
+  /// Read the header of the next record, return true if one is available
+  bool peek_header(Header& header) { return peek(header); }
+
+  /**
+     Read the next record.
+
+     @param header Set to the header of the next record on success.
+     @param capacity Size of `body` in bytes.
+     @param body Set to the body of the next record on success.
+     @return True on success, or false if the ring is empty or the next
+     record body is larger than `capacity` (in which case it is left in the
+     ring).
+  */
+  bool read(Header& header, uint32_t capacity, void* body)
+  {
+    const void* const src = peek(header);
+    if (!src || header.size > capacity) {
+      return false;
+    }
+
+    if (header.size) {
+      memcpy(body, src, header.size);
+    }
+
+    _ring.commit_read(record_size(header.size));
+    return true;
+  }
+
+  /// Skip the next record, return true if there was one
+  bool skip()
+  {
+    Header header{};
+    if (!peek(header)) {
+      return false;
+    }
+
+    _ring.commit_read(record_size(header.size));
+    return true;
+  }
+
+  /**
+     Consume records in place with a callback.
+
+     This takes a single snapshot of the readable data, calls `fn` like
+     `fn(const Header& header, const void* body)` for each complete record in
+     it, then advances the read head once.  This is much cheaper than reading
+     records one at a time when there are many.
+
+     @param fn Function to call for each record.
+     @param max_records Maximum number of records to consume.
+     @return The number of records consumed.
+  */
+  template<class Fn>
+  uint32_t consume(Fn&& fn, uint32_t max_records = UINT32_MAX)
+  {
+    const RingBuffer::ReadVector vec = _ring.read_vector();
+    const RingBuffer::Segment<const char> segments[] = {vec.first, vec.second};
+
+    uint32_t n_records = 0U;
+    uint32_t n_bytes   = 0U;
+    for (const auto& segment : segments) {
+      // Records are never split, so segments contain only whole records
+      uint32_t offset = 0U;
+      while (offset < segment.size && n_records < max_records) {
+        Header header{};
+        memcpy(&header, segment.data + offset, sizeof(Header));
+        if (header.type != padding_type) {
+          fn(static_cast<const Header&>(header),
+             static_cast<const void*>(segment.data + offset + sizeof(Header)));
+          ++n_records;
+        }
+
+        offset += record_size(header.size);
+      }
+
+      n_bytes += offset;
+      if (offset < segment.size) {
+        break;
+      }
+    }
+
+    _ring.commit_read(n_bytes);
+    return n_records;
+  }
+
+private:
+  static constexpr uint32_t record_alignment = 8U;
+
+  static_assert(sizeof(Header) % record_alignment == 0U);
+
+  static uint32_t record_size(uint32_t body_size)
+  {
+    return (uint32_t{sizeof(Header)} + body_size + record_alignment - 1U) &
+           ~(record_alignment - 1U);
+  }
+
+  static void
+  write_record(char* dst, uint32_t type, uint32_t size, const void* body)
+  {
+    const Header header{type, size};
+    memcpy(dst, &header, sizeof(Header));
+    if (body && size) {
+      memcpy(dst + sizeof(Header), body, size);
+    }
+  }
+
+  RingBuffer _ring;
+};
+
+} // namespace raul
+
+#endif // RAUL_RECORDRING_HPP
@@ -0,0 +1,278 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_RECYCLED_HPP
+#define RAUL_RECYCLED_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace raul {
+
+/**
+   Mixin that recycles the memory of deleted objects of a type.
+
+   A class `T` that inherits from `Recycled<T>` gets a class-specific
+   operator new and delete which use a free list for the type.  Deleting an
+   object returns its memory to the list, and creating an object reuses
+   memory from the list if possible, so steady-state churn (like voices or
+   events) doesn't touch the global allocator at all.  Memory is only
+   actually freed by trim().
+
+   This works with Maid, since cleanup() deletes objects and make_managed()
+   creates them with the usual operators:
+
+   @code
+   class Voice
+     : public raul::Maid::Disposable
+     , public raul::Recycled<Voice>
+   {
+     ...
+   };
+   @endcode
+
+   Objects of classes derived from `T` are larger, so aren't recycled, and
+   use the global allocator as usual.
+
+   The free list is lock-free, like the one in Arena, so deleting an object
+   and creating one from a recycled block are real-time safe.  Only creating
+   an object when no blocks are free takes a lock, since that allocates new
+   memory anyway.  Each block has a small header before the object, and at
+   most 2^20 objects of a type can exist at once.
+
+   The pool for each type is never destroyed, so objects can be deleted at
+   any time, even from static destructors like that of a static Maid.
+
+   @ingroup raul
+*/
+template<class T>
+class Recycled
+{
+public:
+  /// Allocate memory for an object, reusing a recycled block if possible
+  static void* operator new(size_t size)
+  {
+    if (size != sizeof(T)) {
+      return ::operator new(size);
+    }
+
+    Pool&          pool  = instance();
+    const uint32_t index = pool.pop(pool.free_head);
+    if (index != none) {
+      pool.n_free.fetch_sub(1U, std::memory_order_relaxed);
+      return object(pool.slot(index).block);
+    }
+
+    return object(pool.slot(pool.allocate()).block);
+  }
+
+  /// Recycle the memory of a deleted object
+  static void operator delete(void* ptr, size_t size)
+  {
+    if (!ptr) {
+      return;
+    }
+
+    if (size != sizeof(T)) {
+      ::operator delete(ptr);
+      return;
+    }
+
+    instance().recycle(header(ptr).index);
+  }
+
+  /**
+     Allocate blocks in advance until at least `count` are free.
+
+     @throw std::bad_alloc if memory can't be allocated.
+  */
+  static void reserve(size_t count)
+  {
+    Pool& pool = instance();
+    while (pool.n_free.load(std::memory_order_relaxed) < count) {
+      pool.recycle(pool.allocate());
+    }
+  }
+
+  /// Free recycled blocks until at most `count` are left
+  static void trim(size_t count = 0U)
+  {
+    Pool& pool = instance();
+    while (pool.n_free.load(std::memory_order_relaxed) > count) {
+      const uint32_t index = pool.pop(pool.free_head);
+      if (index == none) {
+        break;
+      }
+
+      // Slots are never freed, so only the block itself goes away
+      Slot& slot = pool.slot(index);
+      pool.n_free.fetch_sub(1U, std::memory_order_relaxed);
+      ::operator delete(slot.block);
+      slot.block = nullptr;
+      pool.push(pool.empty_head, index);
+    }
+  }
+
+  /// Return the number of recycled blocks that are ready for reuse
+  static size_t n_free()
+  {
+    return instance().n_free.load(std::memory_order_relaxed);
+  }
+
+protected:
+  Recycled() = default;
+
+private:
+  static constexpr uint32_t none      = UINT32_MAX; ///< Null slot index
+  static constexpr uint32_t page_size = 1024U;      ///< Slots per page
+  static constexpr uint32_t max_pages = 1024U;      ///< Maximum pages
+
+  /// Header at the start of every block, before the object
+  struct alignas(std::max_align_t) Header {
+    uint32_t index; ///< Index of the slot for this block
+  };
+
+  /// Slot for a block, which lives as long as the pool (unlike the block)
+  struct Slot {
+    std::atomic<uint32_t> next{none}; ///< Next slot in a list
+    void*                 block{};    ///< Block memory, or null
+  };
+
+  /**
+     Free lists of blocks for this type.
+
+     Blocks are referred to by the index of their slot, so that list heads
+     can be tagged to avoid ABA problems, and links are stored in the slots
+     so that popping never reads a block which trim() may have freed.
+  */
+  struct Pool {
+    /// Pop a slot from a list, or return none if the list is empty
+    uint32_t pop(std::atomic<uint64_t>& head) noexcept
+    {
+      uint64_t h = head.load(std::memory_order_acquire);
+      for (;;) {
+        const auto index = static_cast<uint32_t>(h);
+        if (index == none) {
+          return none;
+        }
+
+        // The tag is incremented on every change, so a stale next is detected
+        const uint32_t next = slot(index).next.load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(h,
+                                       retag(h, next),
+                                       std::memory_order_acquire,
+                                       std::memory_order_acquire)) {
+          return index;
+        }
+      }
+    }
+
+    /// Push a slot onto a list
+    void push(std::atomic<uint64_t>& head, uint32_t index) noexcept
+    {
+      Slot&    s = slot(index);
+      uint64_t h = head.load(std::memory_order_relaxed);
+      do {
+        s.next.store(static_cast<uint32_t>(h), std::memory_order_relaxed);
+      } while (!head.compare_exchange_weak(h,
+                                           retag(h, index),
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+    }
+
+    /// Add a block to the free list
+    void recycle(uint32_t index) noexcept
+    {
+      // Count first so that the count is never less than the list length
+      n_free.fetch_add(1U, std::memory_order_relaxed);
+      push(free_head, index);
+    }
+
+    /// Return the slot with the given index
+    Slot& slot(uint32_t index) noexcept
+    {
+      const size_t page = index / page_size;
+      return pages[page].load(std::memory_order_acquire)[index % page_size];
+    }
+
+    /// Allocate a new block with a slot, and return the slot index
+    uint32_t allocate()
+    {
+      void* const block = ::operator new(sizeof(Header) + sizeof(T));
+
+      uint32_t index = pop(empty_head);
+      if (index == none) {
+        try {
+          index = add_slot();
+        } catch (...) {
+          ::operator delete(block);
+          throw;
+        }
+      }
+
+      slot(index).block = block;
+      new (block) Header{index};
+      return index;
+    }
+
+    /// Add a new slot to the end of the pages
+    uint32_t add_slot()
+    {
+      const std::lock_guard<std::mutex> lock{mutex};
+      if (n_slots == page_size * max_pages) {
+        throw std::bad_alloc{};
+      }
+
+      if (!(n_slots % page_size)) {
+        pages[n_slots / page_size].store(new Slot[page_size],
+                                         std::memory_order_release);
+      }
+
+      return n_slots++;
+    }
+
+    std::mutex            mutex;              ///< Protects adding slots
+    uint32_t              n_slots{0U};        ///< Number of slots
+    std::atomic<Slot*>    pages[max_pages]{}; ///< Pages of slots
+    std::atomic<uint64_t> free_head{none};    ///< Slots with free blocks
+    std::atomic<uint64_t> empty_head{none};   ///< Slots without blocks
+    std::atomic<size_t>   n_free{0U};         ///< Number of free blocks
+  };
+
+  /// Return a new head with the given index and the next tag
+  static uint64_t retag(uint64_t head, uint32_t index)
+  {
+    return (((head >> 32U) + 1U) << 32U) | index;
+  }
+
+  /// Return the object in a block
+  static void* object(void* block)
+  {
+    static_assert(alignof(T) <= alignof(Header),
+                  "Recycled types can't be over-aligned");
+
+    return static_cast<std::byte*>(block) + sizeof(Header);
+  }
+
+  /// Return the header of a block from a pointer to the object in it
+  static Header& header(void* ptr)
+  {
+    return *std::launder(reinterpret_cast<Header*>(
+      static_cast<std::byte*>(ptr) - sizeof(Header)));
+  }
+
+  /// Return the pool for this type, which is created when first used
+  static Pool& instance()
+  {
+    // Deliberately leaked, so that objects can be deleted during exit
+    static Pool* const pool = new Pool{};
+    return *pool;
+  }
+};
+
+} // namespace raul
+
+#endif // RAUL_RECYCLED_HPP
@@ -1,14 +1,19 @@
-// Copyright 2007-2012 David Robillard <d@drobilla.net>
+// Copyright 2007-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #ifndef RAUL_RINGBUFFER_HPP
 #define RAUL_RINGBUFFER_HPP
 
+#include <raul/AllocationPolicy.hpp>
+#include <raul/detail/Util.hpp>
+
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
-#include <memory>
+#include <utility>
 
 namespace raul {
 
@@ -23,15 +28,38 @@ namespace raul {
 class RingBuffer
 {
 public:
+  /// A contiguous region of the buffer
+  template<class Byte>
+  using Segment = detail::Segment<Byte, uint32_t>;
+
+  /// A region of the buffer which may wrap around the end
+  template<class Byte>
+  using Vector = detail::Vector<Byte, uint32_t>;
+
+  using WriteVector = Vector<char>;       ///< Writable space
+  using ReadVector  = Vector<const char>; ///< Readable data
+
+  /// Usage statistics, see stats()
+  struct Stats {
+    uint64_t bytes_written;  ///< Total number of bytes written
+    uint64_t bytes_read;     ///< Total number of bytes read or skipped
+    uint64_t failed_writes;  ///< Number of writes that failed for lack of space
+    uint64_t failed_reads;   ///< Number of reads that failed for lack of data
+    uint32_t high_water;     ///< Highest read space seen by the reader
+  };
+
   /**
      Create a new RingBuffer.
 
      @param size Size in bytes (note this may be rounded up).
+     @param policy How to allocate the contents.
+     @throw std::bad_alloc if the contents can't be allocated.
   */
-  explicit RingBuffer(uint32_t size)
-    : _size(next_power_of_two(size))
+  explicit RingBuffer(uint32_t         size,
+                      AllocationPolicy policy = AllocationPolicy::standard)
+    : _size(detail::next_power_of_two(size))
     , _size_mask(_size - 1)
-    , _buf(new char[_size])
+    , _buf(allocate_array<char>(_size, policy))
   {
     assert(read_space() == 0);
     assert(write_space() == _size - 1);
@@ -39,8 +67,35 @@ public:
 
   RingBuffer(const RingBuffer&)            = delete;
   RingBuffer& operator=(const RingBuffer&) = delete;
-  RingBuffer(RingBuffer&&)                 = default;
-  RingBuffer& operator=(RingBuffer&&)      = default;
+
+  /// Move a RingBuffer, which must not be in use by any other thread
+  RingBuffer(RingBuffer&& other) noexcept
+    : _size(other._size)
+    , _size_mask(other._size_mask)
+    , _buf(std::move(other._buf))
+    , _write_head(other._write_head.load(std::memory_order_relaxed))
+    , _cached_read_head(other._cached_read_head)
+    , _read_head(other._read_head.load(std::memory_order_relaxed))
+    , _cached_write_head(other._cached_write_head)
+  {
+    move_stats(other);
+  }
+
+  /// Move a RingBuffer, neither of which may be in use by any other thread
+  RingBuffer& operator=(RingBuffer&& other) noexcept
+  {
+    _size              = other._size;
+    _size_mask         = other._size_mask;
+    _buf               = std::move(other._buf);
+    _cached_read_head  = other._cached_read_head;
+    _cached_write_head = other._cached_write_head;
+    _write_head.store(other._write_head.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+    _read_head.store(other._read_head.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    move_stats(other);
+    return *this;
+  }
 
   ~RingBuffer() = default;
 
@@ -52,40 +107,79 @@ public:
   */
   void reset()
   {
-    _write_head = 0;
-    _read_head  = 0;
+    _write_head.store(0U, std::memory_order_relaxed);
+    _read_head.store(0U, std::memory_order_relaxed);
+    _cached_read_head  = 0U;
+    _cached_write_head = 0U;
   }
 
   /// Return the number of bytes of space available for reading
   [[nodiscard]] uint32_t read_space() const
   {
-    return read_space_internal(_read_head, _write_head);
+    return read_space_internal(_read_head.load(std::memory_order_relaxed),
+                               _write_head.load(std::memory_order_acquire));
   }
 
   /// Return the number of bytes of space available for writing
   [[nodiscard]] uint32_t write_space() const
   {
-    return write_space_internal(_read_head, _write_head);
+    return write_space_internal(_read_head.load(std::memory_order_acquire),
+                                _write_head.load(std::memory_order_relaxed));
   }
 
   /// Return the capacity (i.e. total write space when empty)
   [[nodiscard]] uint32_t capacity() const { return _size - 1; }
 
+  /**
+     Return usage statistics.
+
+     This may be called from any thread.  Each statistic is read atomically,
+     but they are not a consistent snapshot if the ring is in use.
+
+     The high water mark is sampled by the reader whenever it reloads the
+     write head, which happens on every read_vector() or consume(), and when
+     its cached view shows too little data for a read.  The read space is
+     exact at that point, and only the reader can make it shrink, so this is
+     the true peak as of the reader's last reload.  Data written since then
+     is only counted once the reader looks again.
+  */
+  [[nodiscard]] Stats stats() const
+  {
+    return {_bytes_written.load(std::memory_order_relaxed),
+            _bytes_read.load(std::memory_order_relaxed),
+            _failed_writes.load(std::memory_order_relaxed),
+            _failed_reads.load(std::memory_order_relaxed),
+            _high_water.load(std::memory_order_relaxed)};
+  }
+
+  /**
+     Reset all statistics to zero.
+
+     This method is NOT thread-safe, it may only be called when there are no
+     readers or writers.
+  */
+  void reset_stats()
+  {
+    _bytes_written.store(0U, std::memory_order_relaxed);
+    _failed_writes.store(0U, std::memory_order_relaxed);
+    _bytes_read.store(0U, std::memory_order_relaxed);
+    _failed_reads.store(0U, std::memory_order_relaxed);
+    _high_water.store(0U, std::memory_order_relaxed);
+  }
+
   /// Read from the RingBuffer without advancing the read head
   uint32_t peek(uint32_t size, void* dst)
   {
-    return peek_internal(_read_head, _write_head, size, dst);
+    return peek_internal(_read_head.load(std::memory_order_relaxed), size, dst);
   }
 
   /// Read from the RingBuffer and advance the read head
   uint32_t read(uint32_t size, void* dst)
   {
-    const uint32_t r = _read_head;
-    const uint32_t w = _write_head;
+    const uint32_t r = _read_head.load(std::memory_order_relaxed);
 
-    if (peek_internal(r, w, size, dst)) {
-      std::atomic_thread_fence(std::memory_order_acquire);
-      _read_head = (r + size) & _size_mask;
+    if (peek_internal(r, size, dst)) {
+      advance_read(r, size);
       return size;
     }
 
@@ -95,58 +189,117 @@ public:
   /// Skip data in the RingBuffer (advance read head without reading)
   uint32_t skip(uint32_t size)
   {
-    const uint32_t r = _read_head;
-    const uint32_t w = _write_head;
-    if (read_space_internal(r, w) < size) {
+    const uint32_t r = _read_head.load(std::memory_order_relaxed);
+    if (reader_space(r, size) < size) {
+      increment(_failed_reads, 1U);
       return 0;
     }
 
-    std::atomic_thread_fence(std::memory_order_acquire);
-    _read_head = (r + size) & _size_mask;
+    advance_read(r, size);
     return size;
   }
 
   /// Write data to the RingBuffer
   uint32_t write(uint32_t size, const void* src)
   {
-    const uint32_t r = _read_head;
-    const uint32_t w = _write_head;
-    if (write_space_internal(r, w) < size) {
+    const uint32_t w = _write_head.load(std::memory_order_relaxed);
+    if (writer_space(w, size) < size) {
+      increment(_failed_writes, 1U);
       return 0;
     }
 
-    if (w + size <= _size) {
-      memcpy(&_buf[w], src, size);
-      std::atomic_thread_fence(std::memory_order_release);
-      _write_head = (w + size) & _size_mask;
-    } else {
-      const uint32_t this_size = _size - w;
-      assert(this_size < size);
-      assert(w + this_size <= _size);
-      memcpy(&_buf[w], src, this_size);
-      memcpy(
-        &_buf[0], static_cast<const char*>(src) + this_size, size - this_size);
-      std::atomic_thread_fence(std::memory_order_release);
-      _write_head = size - this_size;
-    }
+    const WriteVector vec = write_vector_internal(w, size);
+    memcpy(vec.first.data, src, vec.first.size);
+    memcpy(vec.second.data,
+           static_cast<const char*>(src) + vec.first.size,
+           vec.second.size);
 
+    advance_write(w, size);
     return size;
   }
 
-private:
-  static uint32_t next_power_of_two(uint32_t size)
-  {
-    // http://graphics.stanford.edu/~seander/bithacks.html#RoundUpPowerOf2
-    size--;
-    size |= size >> 1U;
-    size |= size >> 2U;
-    size |= size >> 4U;
-    size |= size >> 8U;
-    size |= size >> 16U;
-    size++;
-    return size;
+  /**
+     Return all space currently available for writing.
+
+     This allows data to be written directly into the buffer without an
+     intermediate copy.  Nothing is visible to the reader until
+     commit_write() is called.
+  */
+  WriteVector write_vector()
+  {
+    const uint32_t w = _write_head.load(std::memory_order_relaxed);
+    return write_vector_internal(w, writer_space(w, _size));
   }
 
+  /**
+     Advance the write head after writing to a write_vector().
+
+     @param size Number of bytes written, which must be at most the size of
+     the vector returned by the last call to write_vector().
+  */
+  void commit_write(uint32_t size)
+  {
+    assert(size <= write_space());
+    advance_write(_write_head.load(std::memory_order_relaxed), size);
+  }
+
+  /**
+     Return all data currently available for reading.
+
+     This allows data to be read directly from the buffer without an
+     intermediate copy.  The data remains valid until commit_read() is
+     called.
+  */
+  ReadVector read_vector()
+  {
+    const uint32_t r = _read_head.load(std::memory_order_relaxed);
+    return read_vector_internal(r, reader_space(r, _size));
+  }
+
+  /**
+     Consume readable data in place with a callback.
+
+     This takes a single snapshot of the readable data, calls `fn` like
+     `uint32_t fn(const char* data, uint32_t size)` for each contiguous
+     segment of it (at most two), then advances the read head once.  The
+     callback returns the number of bytes it consumed from the segment, and
+     if that is less than the segment size, it is not called again.
+
+     @return The total number of bytes consumed.
+  */
+  template<class Fn>
+  uint32_t consume(Fn&& fn)
+  {
+    const ReadVector vec = read_vector();
+    if (!vec.first.size) {
+      return 0U;
+    }
+
+    uint32_t n_read = fn(vec.first.data, vec.first.size);
+    assert(n_read <= vec.first.size);
+    if (n_read == vec.first.size && vec.second.size) {
+      const uint32_t n_second = fn(vec.second.data, vec.second.size);
+      assert(n_second <= vec.second.size);
+      n_read += n_second;
+    }
+
+    commit_read(n_read);
+    return n_read;
+  }
+
+  /**
+     Advance the read head after reading from a read_vector().
+
+     @param size Number of bytes read, which must be at most the size of the
+     vector returned by the last call to read_vector().
+  */
+  void commit_read(uint32_t size)
+  {
+    assert(size <= read_space());
+    advance_read(_read_head.load(std::memory_order_relaxed), size);
+  }
+
+private:
   [[nodiscard]] uint32_t write_space_internal(uint32_t r, uint32_t w) const
   {
     if (r == w) {
@@ -169,30 +322,129 @@ private:
     return (w - r + _size) & _size_mask;
   }
 
-  uint32_t peek_internal(uint32_t r, uint32_t w, uint32_t size, void* dst) const
+  /**
+     Return the write space as seen by the writer.
+
+     This only reloads the read head if the cached copy indicates that there
+     is not enough space, so the writer usually doesn't touch the reader's
+     cache line at all.
+  */
+  uint32_t writer_space(uint32_t w, uint32_t size)
   {
-    if (read_space_internal(r, w) < size) {
-      return 0;
+    const uint32_t space = write_space_internal(_cached_read_head, w);
+    if (space >= size) {
+      return space;
     }
 
-    if (r + size < _size) {
-      memcpy(dst, &_buf[r], size);
-    } else {
-      const uint32_t first_size = _size - r;
-      memcpy(dst, &_buf[r], first_size);
-      memcpy(static_cast<char*>(dst) + first_size, &_buf[0], size - first_size);
+    _cached_read_head = _read_head.load(std::memory_order_acquire);
+    return write_space_internal(_cached_read_head, w);
+  }
+
+  /// Return the read space as seen by the reader, like writer_space()
+  uint32_t reader_space(uint32_t r, uint32_t size)
+  {
+    const uint32_t space = read_space_internal(r, _cached_write_head);
+    if (space >= size) {
+      return space;
+    }
+
+    _cached_write_head = _write_head.load(std::memory_order_acquire);
+
+    // The space is exact here, so sample it for the high water mark
+    const uint32_t fresh_space = read_space_internal(r, _cached_write_head);
+    if (fresh_space > _high_water.load(std::memory_order_relaxed)) {
+      _high_water.store(fresh_space, std::memory_order_relaxed);
+    }
+
+    return fresh_space;
+  }
+
+  [[nodiscard]] WriteVector write_vector_internal(uint32_t w,
+                                                  uint32_t size) const
+  {
+    const uint32_t first_size = std::min(size, _size - w);
+    return {{&_buf[w], first_size}, {&_buf[0], size - first_size}};
+  }
+
+  [[nodiscard]] ReadVector read_vector_internal(uint32_t r,
+                                                uint32_t size) const
+  {
+    const uint32_t first_size = std::min(size, _size - r);
+    return {{&_buf[r], first_size}, {&_buf[0], size - first_size}};
+  }
+
+  uint32_t peek_internal(uint32_t r, uint32_t size, void* dst)
+  {
+    if (reader_space(r, size) < size) {
+      increment(_failed_reads, 1U);
+      return 0;
     }
 
+    const ReadVector vec = read_vector_internal(r, size);
+    memcpy(dst, vec.first.data, vec.first.size);
+    memcpy(static_cast<char*>(dst) + vec.first.size,
+           vec.second.data,
+           vec.second.size);
+
     return size;
   }
 
-  uint32_t _write_head{}; ///< Read index into _buf
-  uint32_t _read_head{};  ///< Write index into _buf
+  /// Increment a statistic, which is only written by one thread
+  static void increment(std::atomic<uint64_t>& counter, uint64_t n)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  void advance_write(uint32_t w, uint32_t size)
+  {
+    _write_head.store((w + size) & _size_mask, std::memory_order_release);
+    increment(_bytes_written, size);
+  }
+
+  void advance_read(uint32_t r, uint32_t size)
+  {
+    _read_head.store((r + size) & _size_mask, std::memory_order_release);
+    increment(_bytes_read, size);
+  }
+
+  void move_stats(const RingBuffer& other)
+  {
+    const Stats stats = other.stats();
+    _bytes_written.store(stats.bytes_written, std::memory_order_relaxed);
+    _failed_writes.store(stats.failed_writes, std::memory_order_relaxed);
+    _bytes_read.store(stats.bytes_read, std::memory_order_relaxed);
+    _failed_reads.store(stats.failed_reads, std::memory_order_relaxed);
+    _high_water.store(stats.high_water, std::memory_order_relaxed);
+  }
+
+  // Shared and constant after construction
+  uint32_t       _size;      ///< Size (capacity) in bytes
+  uint32_t       _size_mask; ///< Mask for fast modulo
+  ArrayPtr<char> _buf;       ///< Contents
+
+  // Written by the writer, on a separate cache line from the reader's state
+
+  /// Write index into _buf
+  alignas(detail::cache_line_size) std::atomic<uint32_t> _write_head{};
+
+  /// Writer's possibly stale copy of _read_head
+  uint32_t _cached_read_head{};
+
+  std::atomic<uint64_t> _bytes_written{}; ///< Total bytes written
+  std::atomic<uint64_t> _failed_writes{}; ///< Number of failed writes
+
+  // Written by the reader, on a separate cache line from the writer's state
+
+  /// Read index into _buf
+  alignas(detail::cache_line_size) std::atomic<uint32_t> _read_head{};
 
-  uint32_t _size;      ///< Size (capacity) in bytes
-  uint32_t _size_mask; ///< Mask for fast modulo
+  /// Reader's possibly stale copy of _write_head
+  uint32_t _cached_write_head{};
 
-  std::unique_ptr<char[]> _buf; ///< Contents
+  std::atomic<uint64_t> _bytes_read{};   ///< Total bytes read or skipped
+  std::atomic<uint64_t> _failed_reads{}; ///< Number of failed reads
+  std::atomic<uint32_t> _high_water{};   ///< Highest read space on reload
 };
 
 } // namespace raul
@@ -0,0 +1,245 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_SHAREDRINGBUFFER_HPP
+#define RAUL_SHAREDRINGBUFFER_HPP
+
+#include <raul/RingBuffer.hpp>
+#include <raul/detail/FreeRunningRing.hpp>
+#include <raul/detail/Util.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace raul {
+
+/**
+   A lock-free RingBuffer in shared memory for communicating between
+   processes.
+
+   Both the heads and the contents are stored in a named POSIX shared memory
+   object, which one process creates and another attaches to by name.  The
+   heads are lock-free atomics, so once attached, reading and writing is
+   plain memory traffic with no system calls.
+
+   Reading and writing works like RingBuffer, but there is no consume(), and
+   no statistics, since only the heads are shared.  Free-running heads are
+   used, so the capacity is the full size rather than one byte less.  The
+   buffer can't be moved.
+
+   Thread-safe with a single reader and single writer (which may be in
+   different processes), and real-time safe on both ends.
+
+   Since the other process may crash or misbehave, nothing read from shared
+   memory is trusted: the header is validated when attaching, and heads that
+   are impossibly far apart are treated as corruption, which makes the ring
+   appear full and empty rather than accessing memory outside of it.
+
+   @ingroup raul
+*/
+class SharedRingBuffer
+{
+public:
+  using WriteVector = RingBuffer::WriteVector; ///< Writable space
+  using ReadVector  = RingBuffer::ReadVector;  ///< Readable data
+
+  /**
+     Create a new shared memory ring.
+
+     The shared memory object is unlinked when this is destroyed, although
+     processes that are already attached can continue to use it.
+
+     @param name Name of the shared memory object, like "/myring".  Any
+     existing object with the same name is replaced.
+     @param size Size in bytes (note this may be rounded up).
+     @throw std::runtime_error if the shared memory can't be created.
+  */
+  SharedRingBuffer(std::string name, uint32_t size)
+    : _name(std::move(name))
+    , _owner(true)
+  {
+    shm_unlink(_name.c_str());
+
+    const int fd = shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to create shared ring buffer");
+    }
+
+    const uint32_t real_size = detail::next_power_of_two(std::max(size, 2U));
+    const size_t   map_size  = sizeof(Header) + real_size;
+    if (ftruncate(fd, static_cast<off_t>(map_size))) {
+      close(fd);
+      shm_unlink(_name.c_str());
+      throw std::runtime_error("Failed to size shared ring buffer");
+    }
+
+    map(fd, map_size);
+
+    // Initialise the header, setting the magic number last to mark it valid
+    _header       = new (_header) Header{};
+    _header->size = real_size;
+    _header->magic.store(magic_number, std::memory_order_release);
+    attach_header(real_size);
+  }
+
+  /**
+     Attach to an existing shared memory ring.
+
+     @param name Name of the shared memory object, like "/myring".
+     @throw std::runtime_error if the shared memory can't be opened, or isn't
+     a valid ring.
+  */
+  explicit SharedRingBuffer(std::string name)
+    : _name(std::move(name))
+  {
+    const int fd = shm_open(_name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open shared ring buffer");
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+      close(fd);
+      throw std::runtime_error("Invalid shared ring buffer");
+    }
+
+    const auto map_size = static_cast<size_t>(st.st_size);
+    map(fd, map_size);
+
+    // The magic number is set last, so only read the size once it's there
+    if (_header->magic.load(std::memory_order_acquire) != magic_number) {
+      munmap(_header, _map_size);
+      throw std::runtime_error("Invalid shared ring buffer");
+    }
+
+    const uint32_t size = _header->size;
+    if (!size || (size & (size - 1U)) || size > map_size - sizeof(Header)) {
+      munmap(_header, _map_size);
+      throw std::runtime_error("Invalid shared ring buffer");
+    }
+
+    attach_header(size);
+  }
+
+  SharedRingBuffer(const SharedRingBuffer&)            = delete;
+  SharedRingBuffer& operator=(const SharedRingBuffer&) = delete;
+  SharedRingBuffer(SharedRingBuffer&&)                 = delete;
+  SharedRingBuffer& operator=(SharedRingBuffer&&)      = delete;
+
+  ~SharedRingBuffer()
+  {
+    munmap(_header, _map_size);
+    if (_owner) {
+      shm_unlink(_name.c_str());
+    }
+  }
+
+  /// Return the name of the shared memory object
+  [[nodiscard]] const std::string& name() const { return _name; }
+
+  /**
+     Reset (empty) the ring.
+
+     This method is NOT thread-safe, it may only be called when there are no
+     readers or writers in any process.
+  */
+  void reset() { _ring.reset(); }
+
+  /// Return the number of bytes of space available for reading
+  [[nodiscard]] uint32_t read_space() const { return _ring.read_space(); }
+
+  /// Return the number of bytes of space available for writing
+  [[nodiscard]] uint32_t write_space() const { return _ring.write_space(); }
+
+  /// Return the capacity (i.e. total write space when empty)
+  [[nodiscard]] uint32_t capacity() const { return _ring.capacity(); }
+
+  /// Read from the ring without advancing the read head
+  uint32_t peek(uint32_t size, void* dst) { return _ring.peek(size, dst); }
+
+  /// Read from the ring and advance the read head
+  uint32_t read(uint32_t size, void* dst) { return _ring.read(size, dst); }
+
+  /// Skip data in the ring (advance read head without reading)
+  uint32_t skip(uint32_t size) { return _ring.skip(size); }
+
+  /// Write data to the ring
+  uint32_t write(uint32_t size, const void* src)
+  {
+    return _ring.write(size, src);
+  }
+
+  /// Return all space currently available for writing
+  WriteVector write_vector() { return _ring.write_vector(); }
+
+  /// Advance the write head after writing to a write_vector()
+  void commit_write(uint32_t size) { _ring.commit_write(size); }
+
+  /// Return all data currently available for reading
+  ReadVector read_vector() { return _ring.read_vector(); }
+
+  /// Advance the read head after reading from a read_vector()
+  void commit_read(uint32_t size) { _ring.commit_read(size); }
+
+private:
+  using Ring = detail::FreeRunningRing<uint32_t>;
+
+  /// Number stored at the start of shared memory to mark a valid ring
+  static constexpr uint32_t magic_number = 0x52415552U; // "RAUR"
+
+  static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                "Shared memory requires address-free atomics");
+
+  /// The header at the start of shared memory, followed by the contents
+  struct alignas(detail::cache_line_size) Header {
+    std::atomic<uint32_t> magic; ///< Set to magic_number when initialised
+    uint32_t              size;  ///< Size of contents in bytes
+    Ring::Heads           heads; ///< Read and write heads
+  };
+
+  /// Map the shared memory file and close it
+  void map(int fd, size_t map_size)
+  {
+    void* const mem =
+      mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    close(fd);
+    if (mem == MAP_FAILED) {
+      if (_owner) {
+        shm_unlink(_name.c_str());
+      }
+
+      throw std::runtime_error("Failed to map shared ring buffer");
+    }
+
+    _header   = static_cast<Header*>(mem);
+    _map_size = map_size;
+  }
+
+  /// Set up the ring with a validated size, since the header may change
+  void attach_header(uint32_t size)
+  {
+    _ring = Ring{_header->heads, reinterpret_cast<char*>(_header + 1), size};
+  }
+
+  std::string _name;            ///< Shared memory object name
+  bool        _owner{false};    ///< True if this created the object
+  Header*     _header{nullptr}; ///< Start of shared memory
+  size_t      _map_size{0U};    ///< Size of shared memory
+  Ring        _ring;            ///< Reader and writer
+};
+
+} // namespace raul
+
+#endif // RAUL_SHAREDRINGBUFFER_HPP
@@ -0,0 +1,170 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_SPSCQUEUE_HPP
+#define RAUL_SPSCQUEUE_HPP
+
+#include <raul/detail/Util.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace raul {
+
+/**
+   A lock-free queue of objects with a fixed capacity.
+
+   Unlike RingBuffer, this stores objects rather than bytes, so elements can
+   be any type which can be moved without throwing, and are moved in and out
+   of the queue rather than copied as raw memory.  The storage is part of the
+   queue itself, so there is no heap allocation, and the capacity is a
+   compile-time constant so the index arithmetic folds to a mask.
+
+   Thread-safe with a single reader and single writer, and real-time safe
+   on both ends (assuming moving T is).
+
+   @tparam T Element type.
+   @tparam N Capacity, which must be a power of two.
+   @ingroup raul
+*/
+template<class T, size_t N>
+class SpscQueue
+{
+public:
+  static_assert(N > 0U && !(N & (N - 1U)), "Capacity must be a power of 2");
+  static_assert(std::is_nothrow_move_constructible_v<T>);
+  static_assert(std::is_nothrow_destructible_v<T>);
+
+  SpscQueue() = default;
+
+  SpscQueue(const SpscQueue&)            = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+  SpscQueue(SpscQueue&&)                 = delete;
+  SpscQueue& operator=(SpscQueue&&)      = delete;
+
+  ~SpscQueue()
+  {
+    const size_t end = _write_head.load(std::memory_order_relaxed);
+    for (size_t r = _read_head.load(std::memory_order_relaxed); r != end;
+         ++r) {
+      element(r)->~T();
+    }
+  }
+
+  /// Return the maximum number of elements the queue can hold
+  static constexpr size_t capacity() { return N; }
+
+  /// Return the number of elements in the queue
+  [[nodiscard]] size_t size() const
+  {
+    const size_t r = _read_head.load(std::memory_order_acquire);
+    const size_t w = _write_head.load(std::memory_order_acquire);
+    return w - r;
+  }
+
+  /// Return true if the queue is empty
+  [[nodiscard]] bool empty() const { return !size(); }
+
+  /// Push an element, return false if the queue is full
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  /// Push a copy of an element, return false if the queue is full
+  bool try_push(const T& value) { return try_emplace(value); }
+
+  /// Construct an element in place, return false if the queue is full
+  template<class... Args>
+  bool try_emplace(Args&&... args)
+  {
+    const size_t w = _write_head.load(std::memory_order_relaxed);
+    if (w - _cached_read_head == N) {
+      _cached_read_head = _read_head.load(std::memory_order_acquire);
+      if (w - _cached_read_head == N) {
+        return false;
+      }
+    }
+
+    new (slot(w)) T(std::forward<Args>(args)...);
+    _write_head.store(w + 1U, std::memory_order_release);
+    return true;
+  }
+
+  /**
+     Return a pointer to the next element without popping it.
+
+     The element may be modified, and remains valid until it is popped.
+
+     @return The next element, or null if the queue is empty.
+  */
+  T* front()
+  {
+    const size_t r = _read_head.load(std::memory_order_relaxed);
+    if (r == _cached_write_head) {
+      _cached_write_head = _write_head.load(std::memory_order_acquire);
+      if (r == _cached_write_head) {
+        return nullptr;
+      }
+    }
+
+    return element(r);
+  }
+
+  /// Pop an element by moving it into `value`, return false if empty
+  bool try_pop(T& value)
+  {
+    T* const elem = front();
+    if (!elem) {
+      return false;
+    }
+
+    value = std::move(*elem);
+    pop();
+    return true;
+  }
+
+  /// Destroy the next element, which must exist (see front())
+  void pop()
+  {
+    const size_t r = _read_head.load(std::memory_order_relaxed);
+    element(r)->~T();
+    _read_head.store(r + 1U, std::memory_order_release);
+  }
+
+private:
+  /// Mask for fast modulo
+  static constexpr size_t mask = N - 1U;
+
+  /// Return the storage for the element at `pos`
+  std::byte* slot(size_t pos) { return &_storage[(pos & mask) * sizeof(T)]; }
+
+  /// Return the constructed element at `pos`
+  T* element(size_t pos)
+  {
+    return std::launder(reinterpret_cast<T*>(slot(pos)));
+  }
+
+  // Written by the writer, on a separate cache line from the reader's state
+
+  /// Free-running write position
+  alignas(detail::cache_line_size) std::atomic<size_t> _write_head{};
+
+  /// Writer's possibly stale copy of _read_head
+  size_t _cached_read_head{};
+
+  // Written by the reader, on a separate cache line from the writer's state
+
+  /// Free-running read position
+  alignas(detail::cache_line_size) std::atomic<size_t> _read_head{};
+
+  /// Reader's possibly stale copy of _write_head
+  size_t _cached_write_head{};
+
+  /// Elements, on separate cache lines from the heads
+  alignas(detail::cache_line_size) alignas(T) std::byte _storage[N * sizeof(T)];
+};
+
+} // namespace raul
+
+#endif // RAUL_SPSCQUEUE_HPP
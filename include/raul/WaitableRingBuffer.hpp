@@ -0,0 +1,186 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_WAITABLERINGBUFFER_HPP
+#define RAUL_WAITABLERINGBUFFER_HPP
+
+#include <raul/RingBuffer.hpp>
+#include <raul/Semaphore.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace raul {
+
+/**
+   A RingBuffer that the reader can block on until data arrives.
+
+   This is for a non-real-time reader, like a disk or UI thread, which would
+   otherwise have to poll, or have the writer post a semaphore for every
+   message.  Here, the reader announces that it is about to sleep, and the
+   writer only posts when it sees that announcement, so a real-time writer
+   makes no system calls at all while the reader is busy or the data rate is
+   high, and at most one per wakeup otherwise.
+
+   The interface is the same as RingBuffer, except moving is not supported,
+   and the reader may call wait_read_space() to block.  Wakeups may be
+   spurious, so the reader should always check for data after waking.
+
+   Thread-safe with a single reader and single writer.  Writing is real-time
+   safe, but waiting obviously isn't.
+
+   @ingroup raul
+*/
+class WaitableRingBuffer : private RingBuffer
+{
+public:
+  using RingBuffer::ReadVector;
+  using RingBuffer::Stats;
+  using RingBuffer::WriteVector;
+
+  /**
+     Create a new WaitableRingBuffer.
+
+     @param size Size in bytes (note this may be rounded up).
+     @throw std::runtime_error if the semaphore can't be created.
+  */
+  explicit WaitableRingBuffer(uint32_t size)
+    : RingBuffer{size}
+    , _sem{0U}
+  {}
+
+  WaitableRingBuffer(const WaitableRingBuffer&)            = delete;
+  WaitableRingBuffer& operator=(const WaitableRingBuffer&) = delete;
+  WaitableRingBuffer(WaitableRingBuffer&&)                 = delete;
+  WaitableRingBuffer& operator=(WaitableRingBuffer&&)      = delete;
+
+  ~WaitableRingBuffer() = default;
+
+  using RingBuffer::capacity;
+  using RingBuffer::commit_read;
+  using RingBuffer::consume;
+  using RingBuffer::peek;
+  using RingBuffer::read;
+  using RingBuffer::read_space;
+  using RingBuffer::read_vector;
+  using RingBuffer::reset;
+  using RingBuffer::reset_stats;
+  using RingBuffer::skip;
+  using RingBuffer::stats;
+  using RingBuffer::write_space;
+  using RingBuffer::write_vector;
+
+  /// Write data to the ring, waking the reader if it is waiting
+  uint32_t write(uint32_t size, const void* src)
+  {
+    const uint32_t written = RingBuffer::write(size, src);
+    if (written) {
+      notify();
+    }
+
+    return written;
+  }
+
+  /// Advance the write head after writing to a write_vector(), like write()
+  void commit_write(uint32_t size)
+  {
+    RingBuffer::commit_write(size);
+    notify();
+  }
+
+  /**
+     Block until at least `size` bytes are available for reading.
+
+     This may only be called by the reader.
+
+     @return False if `size` is larger than the capacity, otherwise true.
+  */
+  bool wait_read_space(uint32_t size)
+  {
+    if (size > capacity()) {
+      return false;
+    }
+
+    while (prepare_wait(size)) {
+      _sem.wait();
+    }
+
+    return true;
+  }
+
+  /**
+     Block until at least `size` bytes are available for reading, or a
+     timeout has elapsed.
+
+     This may only be called by the reader.
+
+     @return True if at least `size` bytes are available for reading.
+  */
+  template<class Rep, class Period>
+  bool wait_read_space(uint32_t                                  size,
+                       const std::chrono::duration<Rep, Period>& timeout)
+  {
+    using Clock = std::chrono::steady_clock;
+
+    if (size > capacity()) {
+      return false;
+    }
+
+    const auto deadline =
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+
+    while (prepare_wait(size)) {
+      const auto now = Clock::now();
+      if (now >= deadline || !_sem.timed_wait(deadline - now)) {
+        _waiting.store(false, std::memory_order_relaxed);
+        return read_space() >= size;
+      }
+    }
+
+    return true;
+  }
+
+private:
+  /**
+     Announce that the reader is about to sleep, unless there's enough data.
+
+     The fence here and the one in notify() ensure that either the reader
+     sees the new data, or the writer sees that the reader is waiting (or
+     both), so a wakeup is never lost.
+
+     @return True if the reader should sleep on the semaphore.
+  */
+  bool prepare_wait(uint32_t size)
+  {
+    if (read_space() >= size) {
+      return false;
+    }
+
+    _waiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (read_space() >= size) {
+      _waiting.store(false, std::memory_order_relaxed);
+      return false;
+    }
+
+    return true;
+  }
+
+  /// Wake the reader if it is waiting, called after advancing the write head
+  void notify()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiting.load(std::memory_order_relaxed) &&
+        _waiting.exchange(false, std::memory_order_relaxed)) {
+      _sem.post();
+    }
+  }
+
+  Semaphore         _sem;            ///< Posted to wake the reader
+  std::atomic<bool> _waiting{false}; ///< True if the reader may be asleep
+};
+
+} // namespace raul
+
+#endif // RAUL_WAITABLERINGBUFFER_HPP
@@ -0,0 +1,264 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_DETAIL_FREERUNNINGRING_HPP
+#define RAUL_DETAIL_FREERUNNINGRING_HPP
+
+#include <raul/detail/Util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace raul {
+namespace detail {
+
+/**
+   The reader and writer of a ring buffer with free-running heads.
+
+   The heads are counts of bytes that are only masked when accessing the
+   buffer, so the full size is available for writing, and the space is the
+   difference between them.  This implements everything but managing the
+   memory, which is left to the ring that uses it, since the buffer and even
+   the heads may be somewhere special, like in shared memory.
+
+   Heads that are impossibly far apart are treated as corruption, which
+   makes the ring appear full and empty.  This can only happen if something
+   else scribbles on the heads, but it's cheap to check, and keeps accesses
+   within the buffer regardless.
+
+   @tparam Index Unsigned integer type for heads and sizes.
+
+   @tparam mirrored True if the buffer is mapped twice in a row, so regions
+   never need to be split around the end.
+*/
+template<class Index, bool mirrored = false>
+class FreeRunningRing
+{
+public:
+  using WriteVector = Vector<char, Index>;       ///< Writable space
+  using ReadVector  = Vector<const char, Index>; ///< Readable data
+
+  /// The heads, each on a separate cache line
+  struct Heads {
+    /// Free-running write position
+    alignas(cache_line_size) std::atomic<Index> write_head{};
+
+    /// Free-running read position
+    alignas(cache_line_size) std::atomic<Index> read_head{};
+  };
+
+  FreeRunningRing() = default;
+
+  /**
+     Set up a ring.
+
+     @param heads Heads, which must outlive this.
+     @param buf Start of the buffer, which must outlive this.
+     @param size Size of the buffer in bytes, which must be a power of two.
+  */
+  FreeRunningRing(Heads& heads, char* buf, Index size)
+    : _heads{&heads}
+    , _buf{buf}
+    , _size{size}
+    , _size_mask{size - 1U}
+  {
+    assert(size && !(size & _size_mask));
+  }
+
+  /// Reset (empty) the ring, which is NOT thread-safe
+  void reset()
+  {
+    _heads->write_head.store(0U, std::memory_order_relaxed);
+    _heads->read_head.store(0U, std::memory_order_relaxed);
+    _cached_read_head  = 0U;
+    _cached_write_head = 0U;
+  }
+
+  /// Return the number of bytes of space available for reading
+  [[nodiscard]] Index read_space() const
+  {
+    return checked(_heads->write_head.load(std::memory_order_acquire) -
+                   _heads->read_head.load(std::memory_order_relaxed));
+  }
+
+  /// Return the number of bytes of space available for writing
+  [[nodiscard]] Index write_space() const
+  {
+    const Index used = _heads->write_head.load(std::memory_order_relaxed) -
+                       _heads->read_head.load(std::memory_order_acquire);
+
+    return used > _size ? Index{0U} : _size - used;
+  }
+
+  /// Return the capacity (i.e. total write space when empty)
+  [[nodiscard]] Index capacity() const { return _size; }
+
+  /// Return the write head, the total number of bytes written
+  [[nodiscard]] Index write_head() const
+  {
+    return _heads->write_head.load(std::memory_order_relaxed);
+  }
+
+  /// Return the read head, the total number of bytes read
+  [[nodiscard]] Index read_head() const
+  {
+    return _heads->read_head.load(std::memory_order_relaxed);
+  }
+
+  /// Read from the ring without advancing the read head
+  Index peek(Index size, void* dst)
+  {
+    const Index r = read_head();
+    if (reader_space(r, size) < size) {
+      return 0U;
+    }
+
+    const ReadVector vec = region<const char>(r, size);
+    memcpy(dst, vec.first.data, to_size(vec.first.size));
+    memcpy(static_cast<char*>(dst) + vec.first.size,
+           vec.second.data,
+           to_size(vec.second.size));
+
+    return size;
+  }
+
+  /// Read from the ring and advance the read head
+  Index read(Index size, void* dst)
+  {
+    if (peek(size, dst)) {
+      commit_read(size);
+      return size;
+    }
+
+    return 0U;
+  }
+
+  /// Skip data in the ring (advance read head without reading)
+  Index skip(Index size)
+  {
+    const Index r = read_head();
+    if (reader_space(r, size) < size) {
+      return 0U;
+    }
+
+    commit_read(size);
+    return size;
+  }
+
+  /// Write data to the ring
+  Index write(Index size, const void* src)
+  {
+    const Index w = write_head();
+    if (writer_space(w, size) < size) {
+      return 0U;
+    }
+
+    const WriteVector vec = region<char>(w, size);
+    memcpy(vec.first.data, src, to_size(vec.first.size));
+    memcpy(vec.second.data,
+           static_cast<const char*>(src) + vec.first.size,
+           to_size(vec.second.size));
+
+    commit_write(size);
+    return size;
+  }
+
+  /// Return all space currently available for writing
+  WriteVector write_vector()
+  {
+    const Index w = write_head();
+    return region<char>(w, writer_space(w, _size));
+  }
+
+  /// Advance the write head after writing to a write_vector()
+  void commit_write(Index size)
+  {
+    const Index w = write_head();
+
+    // Not in the assertion, so the cache is updated the same in any build
+    [[maybe_unused]] const Index space = writer_space(w, size);
+    assert(size <= space);
+
+    _heads->write_head.store(w + size, std::memory_order_release);
+  }
+
+  /// Return all data currently available for reading
+  ReadVector read_vector()
+  {
+    const Index r = read_head();
+    return region<const char>(r, reader_space(r, _size));
+  }
+
+  /// Advance the read head after reading from a read_vector()
+  void commit_read(Index size)
+  {
+    const Index r = read_head();
+
+    // Outside the assertion, like in commit_write()
+    [[maybe_unused]] const Index space = reader_space(r, size);
+    assert(size <= space);
+
+    _heads->read_head.store(r + size, std::memory_order_release);
+  }
+
+private:
+  /// Return the region of `size` bytes starting at the head `pos`
+  template<class Byte>
+  [[nodiscard]] Vector<Byte, Index> region(Index pos, Index size) const
+  {
+    const Index offset     = pos & _size_mask;
+    const Index first_size = mirrored ? size : std::min(size, _size - offset);
+    return {{_buf + offset, first_size}, {_buf, size - first_size}};
+  }
+
+  /// Return a number of used bytes, or zero if the heads are corrupt
+  [[nodiscard]] Index checked(Index used) const
+  {
+    return used > _size ? Index{0U} : used;
+  }
+
+  /// Return the write space, reloading the read head only if necessary
+  Index writer_space(Index w, Index size)
+  {
+    Index used = w - _cached_read_head;
+    if (used <= _size && _size - used >= size) {
+      return _size - used;
+    }
+
+    _cached_read_head = _heads->read_head.load(std::memory_order_acquire);
+    used              = w - _cached_read_head;
+    return used > _size ? Index{0U} : _size - used;
+  }
+
+  /// Return the read space, reloading the write head only if necessary
+  Index reader_space(Index r, Index size)
+  {
+    const Index space = _cached_write_head - r;
+    if (space <= _size && space >= size) {
+      return space;
+    }
+
+    _cached_write_head = _heads->write_head.load(std::memory_order_acquire);
+    return checked(_cached_write_head - r);
+  }
+
+  // Shared and constant after construction
+  Heads* _heads{};     ///< Heads, which may be in shared memory
+  char*  _buf{};       ///< Start of the buffer
+  Index  _size{};      ///< Size (capacity) in bytes
+  Index  _size_mask{}; ///< Mask for fast modulo
+
+  /// Writer's possibly stale copy of the read head
+  alignas(cache_line_size) Index _cached_read_head{};
+
+  /// Reader's possibly stale copy of the write head
+  alignas(cache_line_size) Index _cached_write_head{};
+};
+
+} // namespace detail
+} // namespace raul
+
+#endif // RAUL_DETAIL_FREERUNNINGRING_HPP
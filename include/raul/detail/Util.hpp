@@ -0,0 +1,71 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RAUL_DETAIL_UTIL_HPP
+#define RAUL_DETAIL_UTIL_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace raul {
+namespace detail {
+
+/// Alignment used to keep data used by different threads on separate lines
+inline constexpr size_t cache_line_size = 64U;
+
+/// Round a nonzero unsigned integer up to the next power of two
+template<class UInt>
+constexpr UInt
+next_power_of_two(UInt size)
+{
+  static_assert(std::is_unsigned_v<UInt>, "Size must be unsigned");
+
+  // http://graphics.stanford.edu/~seander/bithacks.html#RoundUpPowerOf2
+  --size;
+  for (size_t shift = 1U; shift < sizeof(UInt) * 8U; shift *= 2U) {
+    size |= size >> shift;
+  }
+
+  return ++size;
+}
+
+/// Convert an unsigned size which is known to fit to a size_t
+template<class UInt>
+constexpr size_t
+to_size(UInt size)
+{
+  static_assert(std::is_unsigned_v<UInt>, "Size must be unsigned");
+
+  if constexpr (sizeof(UInt) > sizeof(size_t)) {
+    return static_cast<size_t>(size);
+  } else {
+    return size;
+  }
+}
+
+/// A contiguous region of a ring buffer
+template<class Byte, class Size>
+struct Segment {
+  Byte* data; ///< Pointer to the start of the region
+  Size  size; ///< Size of the region in bytes
+};
+
+/**
+   A region of a ring buffer which may wrap around the end.
+
+   The first segment starts at the relevant head, and the second (which is
+   empty if the region does not wrap) starts at the beginning of the buffer.
+*/
+template<class Byte, class Size>
+struct Vector {
+  /// Return the total size of both segments
+  [[nodiscard]] Size size() const { return first.size + second.size; }
+
+  Segment<Byte, Size> first;  ///< Segment starting at the head
+  Segment<Byte, Size> second; ///< Segment starting at the start of the buffer
+};
+
+} // namespace detail
+} // namespace raul
+
+#endif // RAUL_DETAIL_UTIL_HPP
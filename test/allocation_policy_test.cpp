@@ -0,0 +1,77 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/AllocationPolicy.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using raul::AllocationPolicy;
+
+size_t n_live_elements = 0U;
+
+struct Element {
+  Element() { ++n_live_elements; }
+
+  Element(const Element&)            = delete;
+  Element& operator=(const Element&) = delete;
+  Element(Element&&)                 = delete;
+  Element& operator=(Element&&)      = delete;
+
+  ~Element() { --n_live_elements; }
+
+  std::string name{"element"};
+};
+
+void
+test_memory(const AllocationPolicy policy)
+{
+  for (const size_t size : {size_t{1U}, size_t{4096U}, size_t{100000U}}) {
+    void* const    ptr = raul::allocate_memory(size, policy);
+    uint8_t* const mem = static_cast<uint8_t*>(ptr);
+    for (size_t i = 0U; i < size; ++i) {
+      assert(!mem[i]);
+    }
+
+    mem[0]        = 1U;
+    mem[size - 1] = 2U;
+    raul::free_memory(mem, size, policy);
+  }
+}
+
+void
+test_array(const AllocationPolicy policy)
+{
+  {
+    const raul::ArrayPtr<Element> array =
+      raul::allocate_array<Element>(1000U, policy);
+
+    assert(n_live_elements == 1000U);
+    assert(array.get_deleter().count == 1000U);
+    assert(array.get_deleter().policy == policy);
+    assert(array[999].name == "element");
+  }
+
+  assert(n_live_elements == 0U);
+}
+
+} // namespace
+
+int
+main()
+{
+  test_memory(AllocationPolicy::locked);
+  test_memory(AllocationPolicy::huge);
+
+  test_array(AllocationPolicy::standard);
+  test_array(AllocationPolicy::locked);
+  test_array(AllocationPolicy::huge);
+
+  return 0;
+}
@@ -0,0 +1,211 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/AllocationPolicy.hpp>
+#include <raul/Arena.hpp>
+#include <raul/Maid.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Arena = raul::Arena;
+
+class Voice
+  : public raul::Maid::Disposable
+  , public Arena::Allocated
+{
+public:
+  explicit Voice(int note)
+    : _note{note}
+  {
+    if (note < 0) {
+      throw std::runtime_error("Invalid note");
+    }
+  }
+
+  [[nodiscard]] int note() const { return _note; }
+
+private:
+  int _note;
+};
+
+class BigVoice : public Voice
+{
+public:
+  explicit BigVoice(int note)
+    : Voice{note}
+  {}
+
+  char buffer[256]{};
+};
+
+bool
+in_arena(const Arena& arena, const void* ptr, const void* first)
+{
+  const auto* const p     = static_cast<const std::byte*>(ptr);
+  const auto* const begin = static_cast<const std::byte*>(first);
+  return p >= begin && p < begin + (arena.block_size() * arena.n_blocks());
+}
+
+void
+test_blocks()
+{
+  Arena arena{40U, 4U};
+  assert(arena.block_size() == 48U);
+  assert(arena.n_blocks() == 4U);
+
+  // Allocate every block
+  void* blocks[4] = {};
+  for (auto& block : blocks) {
+    block = arena.allocate();
+    assert(block);
+    memset(block, 0xAB, arena.block_size());
+  }
+
+  assert(!arena.allocate());
+
+  // Freed blocks are reused
+  arena.deallocate(blocks[2]);
+  void* const reused = arena.allocate();
+  assert(reused == blocks[2]);
+  assert(!arena.allocate());
+
+  for (auto* block : blocks) {
+    arena.deallocate(block);
+  }
+
+  // Memory can also be allocated with another policy
+  Arena locked{64U, 4U, raul::AllocationPolicy::locked};
+  void* const block = locked.allocate();
+  assert(block);
+  locked.deallocate(block);
+}
+
+void
+test_objects()
+{
+  Arena       arena{64U, 2U};
+  void* const first = arena.allocate();
+  arena.deallocate(first);
+
+  // Objects can be created in the arena
+  auto* const voice1 = new (arena) Voice{60};
+  auto* const voice2 = new (arena) Voice{61};
+  assert(in_arena(arena, voice1, first));
+  assert(in_arena(arena, voice2, first));
+  assert(voice1->note() == 60);
+  assert(voice2->note() == 61);
+
+  // Which returns null when it's exhausted
+  assert(!new (arena) Voice{62});
+
+  // Deleting returns the block to the arena
+  delete voice1;
+  auto* const voice3 = new (arena) Voice{63};
+  assert(voice3);
+  delete voice2;
+  delete voice3;
+
+  // Objects that don't fit can't be created in the arena
+  assert(!new (arena) BigVoice{65});
+
+  // A failed construction returns the block to the arena
+  bool caught = false;
+  try {
+    delete new (arena) Voice{-1};
+  } catch (const std::runtime_error&) {
+    caught = true;
+  }
+
+  assert(caught);
+  auto* const voice5 = new (arena) Voice{66};
+  auto* const voice6 = new (arena) Voice{67};
+  assert(voice5 && voice6);
+  delete voice5;
+  delete voice6;
+}
+
+void
+test_maid()
+{
+  Arena      arena{64U, 2U};
+  raul::Maid maid;
+
+  raul::managed_ptr<Voice> voice1 = maid.make_managed_in<Voice>(arena, 60);
+  raul::managed_ptr<Voice> voice2 = maid.make_managed_in<Voice>(arena, 61);
+  assert(voice1 && voice2);
+  assert(voice1->note() == 60);
+  assert(!maid.make_managed_in<Voice>(arena, 62));
+
+  // The block is returned to the arena when the maid cleans up
+  voice1.reset();
+  assert(!maid.make_managed_in<Voice>(arena, 62));
+  maid.cleanup();
+  voice1 = maid.make_managed_in<Voice>(arena, 62);
+  assert(voice1);
+  assert(voice1->note() == 62);
+}
+
+void
+test_threaded()
+{
+  constexpr uint32_t n_threads = 4U;
+  constexpr uint32_t n_held    = 4U;
+
+  Arena arena{sizeof(uint32_t), n_threads * n_held};
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  for (uint32_t i = 0U; i < n_threads; ++i) {
+    threads.emplace_back([&arena, i] {
+      void* held[n_held] = {};
+      for (uint32_t j = 0U; j < 4096U; ++j) {
+        for (auto& block : held) {
+          block = arena.allocate();
+          assert(block);
+          memcpy(block, &i, sizeof(i));
+        }
+
+        std::this_thread::yield();
+        for (auto* block : held) {
+          uint32_t value = 0U;
+          memcpy(&value, block, sizeof(value));
+          assert(value == i);
+          arena.deallocate(block);
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // All blocks are free again
+  for (uint32_t i = 0U; i < n_threads * n_held; ++i) {
+    assert(arena.allocate());
+  }
+
+  assert(!arena.allocate());
+}
+
+} // namespace
+
+int
+main()
+{
+  test_blocks();
+  test_objects();
+  test_maid();
+  test_threaded();
+  return 0;
+}
@@ -1,8 +1,9 @@
-// Copyright 2007-2019 David Robillard <d@drobilla.net>
+// Copyright 2007-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #undef NDEBUG
 
+#include <raul/AllocationPolicy.hpp>
 #include <raul/Array.hpp>
 
 #include <cassert>
@@ -35,5 +36,20 @@ main()
   assert(array3[0] == 47);
   assert(array3.size() == 8);
 
+  const raul::Array<int> array4{8, raul::AllocationPolicy::locked};
+  assert(array4.size() == 8);
+  assert(array4[7] == 0);
+
+  raul::Array<int> array5{4, 3, raul::AllocationPolicy::huge};
+  assert(array5.size() == 4);
+  assert(array5[3] == 3);
+
+  array5.alloc(16, 5, raul::AllocationPolicy::locked);
+  assert(array5.size() == 16);
+  assert(array5[15] == 5);
+
+  array5.alloc(0, raul::AllocationPolicy::locked);
+  assert(array5.size() == 0);
+
   return 0;
 }
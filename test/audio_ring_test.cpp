@@ -0,0 +1,275 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/AllocationPolicy.hpp>
+#include <raul/AudioRing.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using AudioRing = raul::AudioRing;
+using Format    = AudioRing::Format;
+
+constexpr uint32_t n_channels = 3U;
+
+float
+sample_value(uint32_t channel, uint32_t frame)
+{
+  return static_cast<float>((frame * n_channels) + channel) / 1024.0f;
+}
+
+void
+test_planar()
+{
+  AudioRing ring{n_channels, 10U};
+  assert(ring.n_channels() == n_channels);
+  assert(ring.capacity() == 10U);
+  assert(ring.write_space() == 10U);
+  assert(!ring.read_space());
+
+  std::vector<float> in[n_channels];
+  std::vector<float> out[n_channels];
+  float*             in_ptrs[n_channels]  = {};
+  float*             out_ptrs[n_channels] = {};
+  for (uint32_t c = 0U; c < n_channels; ++c) {
+    in[c].resize(16U);
+    out[c].resize(16U);
+    in_ptrs[c]  = in[c].data();
+    out_ptrs[c] = out[c].data();
+  }
+
+  // Write and read blocks of varying size, so frames are split at every offset
+  uint32_t n_written = 0U;
+  for (uint32_t i = 0U; i < 256U; ++i) {
+    const uint32_t n_frames = 1U + (i % 7U);
+    for (uint32_t c = 0U; c < n_channels; ++c) {
+      for (uint32_t f = 0U; f < n_frames; ++f) {
+        in[c][f] = sample_value(c, n_written + f);
+      }
+    }
+
+    assert(ring.write_planar(in_ptrs, n_frames) == n_frames);
+    assert(ring.read_space() == n_frames);
+    assert(ring.read_planar(out_ptrs, 16U) == n_frames);
+    assert(!ring.read_space());
+
+    for (uint32_t c = 0U; c < n_channels; ++c) {
+      for (uint32_t f = 0U; f < n_frames; ++f) {
+        assert(out[c][f] == sample_value(c, n_written + f));
+      }
+    }
+
+    n_written += n_frames;
+  }
+
+  // Writes are truncated to the available space
+  assert(ring.write_planar(in_ptrs, 16U) == 10U);
+  assert(!ring.write_planar(in_ptrs, 1U));
+
+  ring.reset();
+  assert(!ring.read_space());
+}
+
+void
+test_interleaved()
+{
+  AudioRing ring{n_channels, 10U};
+
+  float  in[16U * n_channels]    = {};
+  float  out[16U * n_channels]   = {};
+  float  planar[n_channels][16U] = {};
+  float* planar_ptrs[n_channels] = {};
+  for (uint32_t c = 0U; c < n_channels; ++c) {
+    planar_ptrs[c] = planar[c];
+  }
+
+  // Interleaved float in and out, and planar out, across the wrap
+  uint32_t n_written = 0U;
+  for (uint32_t i = 0U; i < 64U; ++i) {
+    const uint32_t n_frames = 1U + (i % 9U);
+    for (uint32_t f = 0U; f < n_frames; ++f) {
+      for (uint32_t c = 0U; c < n_channels; ++c) {
+        in[(f * n_channels) + c] = sample_value(c, n_written + f);
+      }
+    }
+
+    assert(ring.write_interleaved(Format::float32, in, n_frames) == n_frames);
+    if (i % 2U) {
+      assert(ring.read_interleaved(Format::float32, out, 16U) == n_frames);
+      assert(!memcmp(in, out, n_frames * n_channels * sizeof(float)));
+    } else {
+      assert(ring.read_planar(planar_ptrs, 16U) == n_frames);
+      for (uint32_t f = 0U; f < n_frames; ++f) {
+        for (uint32_t c = 0U; c < n_channels; ++c) {
+          assert(planar[c][f] == sample_value(c, n_written + f));
+        }
+      }
+    }
+
+    n_written += n_frames;
+  }
+}
+
+void
+test_int16()
+{
+  AudioRing ring{1U, 16U};
+
+  // Integer samples round-trip exactly
+  const int16_t in[] = {0, 1, -1, 16384, -16384, 32767, -32767};
+  int16_t       out[8]{};
+  assert(ring.write_interleaved(Format::int16, in, 7U) == 7U);
+  assert(ring.read_interleaved(Format::int16, out, 8U) == 7U);
+  assert(!memcmp(in, out, sizeof(in)));
+
+  // Floats are converted, rounded, and clipped
+  const float floats[] = {0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 2.0f, -2.0f};
+  const float* const floats_ptr = floats;
+  assert(ring.write_planar(&floats_ptr, 7U) == 7U);
+  assert(ring.read_interleaved(Format::int16, out, 8U) == 7U);
+  assert(out[0] == 0);
+  assert(out[1] == 16384);
+  assert(out[2] == -16384);
+  assert(out[3] == 32767);
+  assert(out[4] == -32767);
+  assert(out[5] == 32767);
+  assert(out[6] == -32767);
+
+  // NaN is silence
+  const float nans[] = {0.25f, std::numeric_limits<float>::quiet_NaN()};
+  assert(ring.write_interleaved(Format::float32, nans, 2U) == 2U);
+  assert(ring.read_interleaved(Format::int16, out, 8U) == 2U);
+  assert(out[0] == 8192);
+  assert(out[1] == 0);
+
+  // Integers are converted to floats in [-1, 1]
+  float        converted[8]{};
+  float* const converted_ptr = converted;
+  assert(ring.write_interleaved(Format::int16, in, 7U) == 7U);
+  assert(ring.read_planar(&converted_ptr, 8U) == 7U);
+  assert(converted[0] == 0.0f);
+  assert(converted[5] == 1.0f);
+  assert(converted[6] == -1.0f);
+}
+
+void
+test_int24()
+{
+  AudioRing ring{2U, 8U};
+
+  // Packed little-endian samples round-trip exactly, including the sign
+  const uint8_t in[] = {
+    0x00, 0x00, 0x00, // 0
+    0x01, 0x00, 0x00, // 1
+    0xFF, 0xFF, 0xFF, // -1
+    0xFF, 0xFF, 0x7F, // 8388607
+    0x01, 0x00, 0x80, // -8388607
+    0x56, 0x34, 0x12, // 0x123456
+  };
+
+  uint8_t out[sizeof(in)] = {};
+  assert(ring.write_interleaved(Format::int24, in, 3U) == 3U);
+  assert(ring.read_interleaved(Format::int24, out, 8U) == 3U);
+  assert(!memcmp(in, out, sizeof(in)));
+
+  float converted[6]{};
+  assert(ring.write_interleaved(Format::int24, in, 3U) == 3U);
+  assert(ring.read_interleaved(Format::float32, converted, 8U) == 3U);
+  assert(converted[0] == 0.0f);
+  assert(converted[1] > 0.0f);
+  assert(converted[2] < 0.0f);
+  assert(converted[3] == 1.0f);
+  assert(converted[4] == -1.0f);
+
+  // Floats are clipped
+  const float floats[] = {2.0f, -2.0f};
+  assert(ring.write_interleaved(Format::float32, floats, 1U) == 1U);
+  assert(ring.read_interleaved(Format::int24, out, 8U) == 1U);
+  assert(!memcmp(out, in + 9U, 6U));
+}
+
+void
+test_large()
+{
+  // Long runs are converted in several blocks
+  constexpr uint32_t n_frames = 300U;
+
+  AudioRing            ring{2U, n_frames};
+  std::vector<float>   floats(2U * n_frames);
+  std::vector<uint8_t> packed(3U * 2U * n_frames);
+  std::vector<float>   out(2U * n_frames);
+  for (size_t i = 0U; i < floats.size(); ++i) {
+    floats[i] = (static_cast<float>(i) / 300.0f) - 1.0f;
+  }
+
+  for (const Format format : {Format::int16, Format::int24}) {
+    assert(ring.write_interleaved(Format::float32, floats.data(), n_frames) ==
+           n_frames);
+    assert(ring.read_interleaved(format, packed.data(), n_frames) ==
+           n_frames);
+    assert(ring.write_interleaved(format, packed.data(), n_frames) ==
+           n_frames);
+    assert(ring.read_interleaved(Format::float32, out.data(), n_frames) ==
+           n_frames);
+
+    for (size_t i = 0U; i < floats.size(); ++i) {
+      assert(std::fabs(out[i] - floats[i]) < 1.0f / 16384.0f);
+    }
+  }
+
+  // Rings that are too large are rejected
+  bool caught = false;
+  try {
+    const AudioRing huge{1U << 16U, 1U << 16U};
+  } catch (const std::length_error&) {
+    caught = true;
+  }
+  assert(caught);
+}
+
+void
+test_capacity()
+{
+  // Power of two sizes use the whole buffer without doubling it
+  const AudioRing mono{1U, 16U};
+  assert(mono.capacity() == 16U);
+
+  // Other sizes are rounded up to whole frames that fit in the buffer
+  const AudioRing stereo{2U, 100U};
+  assert(stereo.capacity() == 128U);
+
+  for (const auto policy : {raul::AllocationPolicy::locked,
+                            raul::AllocationPolicy::huge}) {
+    AudioRing   ring{2U, 8U, policy};
+    const float in[]  = {0.25f, -0.25f};
+    float       out[] = {0.0f, 0.0f};
+    assert(ring.capacity() == 8U);
+    assert(ring.write_interleaved(Format::float32, in, 1U) == 1U);
+    assert(ring.read_interleaved(Format::float32, out, 1U) == 1U);
+    assert(!memcmp(in, out, sizeof(in)));
+  }
+}
+
+} // namespace
+
+int
+main()
+{
+  test_planar();
+  test_interleaved();
+  test_int16();
+  test_int24();
+  test_large();
+  test_capacity();
+  return 0;
+}
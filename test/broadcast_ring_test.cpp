@@ -0,0 +1,157 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/BroadcastRing.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace {
+
+using BroadcastRing = raul::BroadcastRing;
+
+constexpr uint32_t n_msgs    = 1U << 16U;
+constexpr uint32_t n_words   = 5U;
+constexpr uint32_t n_readers = 3U;
+
+void
+test_single_threaded()
+{
+  BroadcastRing ring{3U, 12U};
+  assert(ring.n_slots() == 4U);
+  assert(ring.slot_size() == 12U);
+
+  BroadcastRing::Reader reader1{ring};
+  char                  buf[16] = {};
+  assert(!reader1.read_space());
+  assert(!reader1.read(sizeof(buf), buf));
+
+  // Messages larger than a slot can't be written
+  assert(!ring.write(13U, "0123456789abc"));
+
+  // Every reader sees every message
+  assert(ring.write(5U, "hello"));
+  BroadcastRing::Reader reader2{ring};
+  assert(ring.write(3U, "foo"));
+  assert(ring.n_written() == 2U);
+
+  assert(reader1.read_space() == 2U);
+  assert(reader1.read(sizeof(buf), buf) == 5U);
+  assert(!strncmp(buf, "hello", 5U));
+  assert(reader1.read(sizeof(buf), buf) == 3U);
+  assert(!strncmp(buf, "foo", 3U));
+  assert(!reader1.read(sizeof(buf), buf));
+
+  // A reader starts at the next message
+  assert(reader2.read_space() == 1U);
+  assert(reader2.read(sizeof(buf), buf) == 3U);
+  assert(!strncmp(buf, "foo", 3U));
+
+  // A lapped reader skips to the oldest intact message
+  for (char c = 'a'; c < 'a' + 10; ++c) {
+    assert(ring.write(1U, &c));
+  }
+
+  assert(reader1.read_space() == 4U);
+  assert(reader1.read(sizeof(buf), buf) == 1U);
+  assert(buf[0] == 'h');
+  assert(reader1.lost() == 7U);
+  assert(reader1.read(sizeof(buf), buf) == 1U);
+  assert(buf[0] == 'i');
+  assert(reader1.read(sizeof(buf), buf) == 1U);
+  assert(buf[0] == 'j');
+  assert(!reader1.read(sizeof(buf), buf));
+  assert(reader2.lost() == 0U);
+
+  // Messages larger than the reader's buffer are skipped
+  assert(ring.write(12U, "0123456789ab"));
+  assert(ring.write(2U, "ok"));
+  assert(reader1.read(4U, buf) == 2U);
+  assert(!strncmp(buf, "ok", 2U));
+  assert(reader1.lost() == 8U);
+}
+
+void
+writer(BroadcastRing& ring)
+{
+  uint32_t msg[n_words] = {};
+  for (uint32_t i = 0U; i < n_msgs; ++i) {
+    for (uint32_t& word : msg) {
+      word = i;
+    }
+
+    assert(ring.write(sizeof(msg), msg));
+    if (!(i % 64U)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+reader(BroadcastRing::Reader& reader, std::atomic<bool>& done)
+{
+  uint32_t n_read = 0U;
+  uint32_t last   = 0U;
+  uint32_t msg[n_words];
+  for (;;) {
+    const bool finished = done.load(std::memory_order_acquire);
+    if (reader.read(sizeof(msg), msg)) {
+      // Messages are never torn, and arrive in order
+      for (const uint32_t word : msg) {
+        assert(word == msg[0]);
+      }
+
+      assert(!n_read || msg[0] > last);
+      last = msg[0];
+      ++n_read;
+    } else if (finished) {
+      break;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  assert(n_read + reader.lost() == n_msgs);
+}
+
+void
+test_threaded()
+{
+  BroadcastRing     ring{16U, n_words * sizeof(uint32_t)};
+  std::atomic<bool> done{false};
+
+  BroadcastRing::Reader readers[n_readers] = {
+    BroadcastRing::Reader{ring},
+    BroadcastRing::Reader{ring},
+    BroadcastRing::Reader{ring},
+  };
+
+  std::thread reader_threads[n_readers];
+  for (uint32_t i = 0U; i < n_readers; ++i) {
+    reader_threads[i] =
+      std::thread(reader, std::ref(readers[i]), std::ref(done));
+  }
+
+  writer(ring);
+  done.store(true, std::memory_order_release);
+
+  for (std::thread& thread : reader_threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_threaded();
+  return 0;
+}
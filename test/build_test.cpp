@@ -1,19 +1,33 @@
-// Copyright 2007-2017 David Robillard <d@drobilla.net>
+// Copyright 2007-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <raul/Arena.hpp>
 #include <raul/Array.hpp>
+#include <raul/AudioRing.hpp>
+#include <raul/BroadcastRing.hpp>
 #include <raul/Deletable.hpp>
 #include <raul/DoubleBuffer.hpp>
+#include <raul/EpochMaid.hpp>
 #include <raul/Exception.hpp>
+#include <raul/LargeRingBuffer.hpp>
+#include <raul/LossyRingBuffer.hpp>
 #include <raul/Maid.hpp>
+#include <raul/MpmcQueue.hpp>
+#include <raul/MpscRingBuffer.hpp>
 #include <raul/Noncopyable.hpp>
 #include <raul/Path.hpp>
+#include <raul/RecordRing.hpp>
+#include <raul/Recycled.hpp>
 #include <raul/RingBuffer.hpp>
 #include <raul/Semaphore.hpp>
+#include <raul/SpscQueue.hpp>
 #include <raul/Symbol.hpp>
+#include <raul/WaitableRingBuffer.hpp>
 
 #ifndef _WIN32
+#  include <raul/MirroredRingBuffer.hpp>
 #  include <raul/Process.hpp>
+#  include <raul/SharedRingBuffer.hpp>
 #  include <raul/Socket.hpp>
 #endif
 
@@ -23,18 +37,33 @@ class DeletableThing : public raul::Deletable
 class NonCopyableThing : public raul::Noncopyable
 {};
 
+class RecycledThing : public raul::Recycled<RecycledThing>
+{};
+
 int
 main()
 {
-  const raul::Array<int>        array;
-  const DeletableThing          deletable;
-  const raul::DoubleBuffer<int> double_buffer(0);
-  const raul::Maid              maid;
-  const NonCopyableThing        non_copyable;
-  const raul::Path              path;
-  const raul::RingBuffer        ring_buffer(64U);
-  const raul::Semaphore         semaphore(0U);
-  const raul::Symbol            symbol("foo");
+  const raul::Arena              arena(64U, 1U);
+  const raul::Array<int>         array;
+  const raul::AudioRing          audio_ring(1U, 1U);
+  const raul::BroadcastRing      broadcast_ring(4U, 16U);
+  const DeletableThing           deletable;
+  const raul::DoubleBuffer<int>  double_buffer(0);
+  const raul::EpochMaid          epoch_maid(1U);
+  const raul::LargeRingBuffer    large_ring_buffer(64U);
+  const raul::LossyRingBuffer    lossy_ring_buffer(64U);
+  const raul::Maid               maid;
+  const raul::MpmcQueue<int>     mpmc_queue(64U);
+  const raul::MpscRingBuffer     mpsc_ring_buffer(64U);
+  const NonCopyableThing         non_copyable;
+  const raul::Path               path;
+  const raul::RecordRing         record_ring(64U);
+  const RecycledThing            recycled;
+  const raul::RingBuffer         ring_buffer(64U);
+  const raul::Semaphore          semaphore(0U);
+  const raul::SpscQueue<int, 4U> spsc_queue{};
+  const raul::Symbol             symbol("foo");
+  const raul::WaitableRingBuffer waitable_ring_buffer(64U);
 
   try {
     const raul::Symbol bad_symbol("not a valid symbol!");
@@ -50,20 +79,36 @@ main()
   raul::Process::launch(cmd);
 #  endif
 
-  const raul::Socket socket(raul::Socket::Type::UNIX);
+  const raul::MirroredRingBuffer mirrored_ring_buffer(64U);
+  const raul::SharedRingBuffer   shared_ring_buffer("/raul-build-test", 64U);
+  const raul::Socket             socket(raul::Socket::Type::UNIX);
 
+  (void)mirrored_ring_buffer;
+  (void)shared_ring_buffer;
   (void)socket;
 
 #endif
 
+  (void)arena;
   (void)array;
+  (void)audio_ring;
+  (void)broadcast_ring;
   (void)deletable;
   (void)double_buffer;
+  (void)epoch_maid;
+  (void)large_ring_buffer;
+  (void)lossy_ring_buffer;
   (void)maid;
+  (void)mpmc_queue;
+  (void)mpsc_ring_buffer;
   (void)non_copyable;
   (void)path;
+  (void)record_ring;
+  (void)recycled;
   (void)ring_buffer;
+  (void)spsc_queue;
   (void)symbol;
+  (void)waitable_ring_buffer;
 
   return 0;
 }
@@ -0,0 +1,183 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/EpochMaid.hpp>
+#include <raul/Maid.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using EpochMaid = raul::EpochMaid;
+
+constexpr size_t n_readers = 3U;
+constexpr size_t n_updates = 1U << 14U;
+
+std::atomic<size_t> n_nodes{0U};
+
+class Node : public raul::Maid::Disposable
+{
+public:
+  explicit Node(size_t value)
+    : _value{value}
+    , _check{~value}
+  {
+    ++n_nodes;
+  }
+
+  Node(const Node&)            = delete;
+  Node& operator=(const Node&) = delete;
+  Node(Node&&)                 = delete;
+  Node& operator=(Node&&)      = delete;
+
+  ~Node() override
+  {
+    _check = _value; // Poison, so reading a deleted node is likely caught
+    --n_nodes;
+  }
+
+  [[nodiscard]] size_t value() const { return _value; }
+  [[nodiscard]] bool   valid() const { return _check == ~_value; }
+
+private:
+  size_t _value;
+  size_t _check;
+};
+
+void
+test_single_threaded()
+{
+  EpochMaid maid{2U};
+  assert(maid.empty());
+
+  maid.retire(nullptr); // Mustn't crash
+
+  // Without readers, everything retired is deleted immediately
+  maid.retire(new Node(1U));
+  maid.retire(new Node(2U));
+  assert(!maid.empty());
+  assert(n_nodes == 2U);
+  maid.cleanup();
+  assert(maid.empty());
+  assert(n_nodes == 0U);
+
+  {
+    EpochMaid::Reader reader1{maid};
+    EpochMaid::Reader reader2{maid};
+
+    // There are only two slots
+    bool caught = false;
+    try {
+      const EpochMaid::Reader reader3{maid};
+    } catch (const std::runtime_error&) {
+      caught = true;
+    }
+
+    assert(caught);
+
+    // Unlocked readers don't prevent deletion
+    maid.retire(new Node(3U));
+    maid.cleanup();
+    assert(n_nodes == 0U);
+
+    // A locked reader prevents deletion until it unlocks
+    reader1.lock();
+    maid.retire(new Node(4U));
+    maid.cleanup();
+    maid.cleanup();
+    maid.cleanup();
+    assert(n_nodes == 1U);
+    reader1.unlock();
+    maid.cleanup();
+    assert(n_nodes == 0U);
+
+    // Objects retired while a reader is locked wait for it too
+    reader2.lock();
+    maid.cleanup();
+    maid.retire(new Node(5U));
+    maid.cleanup();
+    assert(n_nodes == 1U);
+    reader2.unlock();
+    maid.cleanup();
+    assert(n_nodes == 0U);
+  }
+
+  // Slots are freed when readers are destroyed
+  const EpochMaid::Reader reader3{maid};
+
+  // Retired objects are deleted along with the EpochMaid
+  maid.retire(new Node(6U));
+}
+
+void
+reader_thread(EpochMaid&                maid,
+              const std::atomic<Node*>& shared,
+              const std::atomic<bool>&  done)
+{
+  EpochMaid::Reader reader{maid};
+  size_t            last = 0U;
+  while (!done.load(std::memory_order_acquire)) {
+    const std::lock_guard<EpochMaid::Reader> guard{reader};
+
+    const Node* const node = shared.load(std::memory_order_acquire);
+    assert(node->valid());
+    assert(node->value() >= last);
+    last = node->value();
+    std::this_thread::yield();
+  }
+}
+
+void
+test_threaded()
+{
+  EpochMaid          maid{n_readers};
+  std::atomic<Node*> shared{new Node(0U)};
+  std::atomic<bool>  done{false};
+
+  std::vector<std::thread> readers;
+  readers.reserve(n_readers);
+  for (size_t i = 0U; i < n_readers; ++i) {
+    readers.emplace_back(
+      reader_thread, std::ref(maid), std::cref(shared), std::cref(done));
+  }
+
+  // Replace the shared node, and clean up as we go
+  for (size_t i = 1U; i <= n_updates; ++i) {
+    maid.retire(shared.exchange(new Node(i), std::memory_order_acq_rel));
+    if (i % 16U == 0U) {
+      maid.cleanup();
+      std::this_thread::yield();
+    }
+  }
+
+  done.store(true, std::memory_order_release);
+  for (auto& thread : readers) {
+    thread.join();
+  }
+
+  maid.cleanup();
+  assert(maid.empty());
+  assert(n_nodes == 1U);
+  delete shared.load();
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  assert(n_nodes == 0U);
+  test_threaded();
+  assert(n_nodes == 0U);
+  return 0;
+}
@@ -1,20 +1,35 @@
-// Copyright 2022 David Robillard <d@drobilla.net>
+// Copyright 2022-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
-#include <raul/Array.hpp>        // IWYU pragma: keep
-#include <raul/Deletable.hpp>    // IWYU pragma: keep
-#include <raul/DoubleBuffer.hpp> // IWYU pragma: keep
-#include <raul/Exception.hpp>    // IWYU pragma: keep
-#include <raul/Maid.hpp>         // IWYU pragma: keep
-#include <raul/Noncopyable.hpp>  // IWYU pragma: keep
-#include <raul/Path.hpp>         // IWYU pragma: keep
-#include <raul/RingBuffer.hpp>   // IWYU pragma: keep
-#include <raul/Semaphore.hpp>    // IWYU pragma: keep
-#include <raul/Symbol.hpp>       // IWYU pragma: keep
+#include <raul/AllocationPolicy.hpp>   // IWYU pragma: keep
+#include <raul/Arena.hpp>              // IWYU pragma: keep
+#include <raul/Array.hpp>              // IWYU pragma: keep
+#include <raul/AudioRing.hpp>          // IWYU pragma: keep
+#include <raul/BroadcastRing.hpp>      // IWYU pragma: keep
+#include <raul/Deletable.hpp>          // IWYU pragma: keep
+#include <raul/DoubleBuffer.hpp>       // IWYU pragma: keep
+#include <raul/EpochMaid.hpp>          // IWYU pragma: keep
+#include <raul/Exception.hpp>          // IWYU pragma: keep
+#include <raul/LargeRingBuffer.hpp>    // IWYU pragma: keep
+#include <raul/LossyRingBuffer.hpp>    // IWYU pragma: keep
+#include <raul/Maid.hpp>               // IWYU pragma: keep
+#include <raul/MpmcQueue.hpp>          // IWYU pragma: keep
+#include <raul/MpscRingBuffer.hpp>     // IWYU pragma: keep
+#include <raul/Noncopyable.hpp>        // IWYU pragma: keep
+#include <raul/Path.hpp>               // IWYU pragma: keep
+#include <raul/RecordRing.hpp>         // IWYU pragma: keep
+#include <raul/Recycled.hpp>           // IWYU pragma: keep
+#include <raul/RingBuffer.hpp>         // IWYU pragma: keep
+#include <raul/Semaphore.hpp>          // IWYU pragma: keep
+#include <raul/SpscQueue.hpp>          // IWYU pragma: keep
+#include <raul/Symbol.hpp>             // IWYU pragma: keep
+#include <raul/WaitableRingBuffer.hpp> // IWYU pragma: keep
 
 #ifndef _WIN32
-#  include <raul/Process.hpp> // IWYU pragma: keep
-#  include <raul/Socket.hpp>  // IWYU pragma: keep
+#  include <raul/MirroredRingBuffer.hpp> // IWYU pragma: keep
+#  include <raul/Process.hpp>            // IWYU pragma: keep
+#  include <raul/SharedRingBuffer.hpp>   // IWYU pragma: keep
+#  include <raul/Socket.hpp>             // IWYU pragma: keep
 #endif
 
 #ifdef __GNUC__
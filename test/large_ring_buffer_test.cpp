@@ -0,0 +1,163 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/LargeRingBuffer.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using LargeRingBuffer = raul::LargeRingBuffer;
+
+constexpr uint32_t n_msgs   = 1U << 16U;
+constexpr uint32_t msg_size = 100U;
+
+void
+test_single_threaded()
+{
+  LargeRingBuffer ring{10U};
+  assert(ring.capacity() == 16U);
+  assert(ring.write_space() == 16U);
+  assert(ring.read_space() == 0U);
+
+  char buf[16] = {};
+  assert(!ring.read(1U, buf));
+  assert(!ring.skip(1U));
+
+  // Write across the end
+  assert(ring.write(12U, "abcdefghijkl") == 12U);
+  assert(ring.skip(12U) == 12U);
+  assert(ring.write(8U, "ABCDEFGH") == 8U);
+
+  const LargeRingBuffer::ReadVector vec = ring.read_vector();
+  assert(vec.first.size == 4U);
+  assert(vec.second.size == 4U);
+  assert(!strncmp(vec.first.data, "ABCD", 4U));
+  assert(!strncmp(vec.second.data, "EFGH", 4U));
+
+  assert(ring.peek(8U, buf) == 8U);
+  assert(!strncmp(buf, "ABCDEFGH", 8U));
+  assert(ring.read(8U, buf) == 8U);
+  assert(!strncmp(buf, "ABCDEFGH", 8U));
+
+  // The full size can be used
+  assert(ring.write(16U, "0123456789ABCDEF") == 16U);
+  assert(ring.write_space() == 0U);
+  assert(ring.read_space() == 16U);
+  assert(!ring.write(1U, "X"));
+  assert(ring.read(16U, buf) == 16U);
+  assert(!strncmp(buf, "0123456789ABCDEF", 16U));
+
+  assert(ring.total_written() == 36U);
+  assert(ring.total_read() == 36U);
+
+  ring.reset();
+  assert(ring.read_space() == 0U);
+  assert(ring.write_space() == 16U);
+  assert(ring.total_written() == 0U);
+  assert(ring.total_read() == 0U);
+}
+
+void
+test_large_totals()
+{
+  // Stream more than 4 GiB through the ring without copying
+  constexpr uint64_t total = (uint64_t{1U} << 32U) + 3000U;
+
+  LargeRingBuffer ring{1U << 16U};
+  while (ring.total_read() < total) {
+    const LargeRingBuffer::WriteVector wvec = ring.write_vector();
+    assert(wvec.size() == ring.capacity());
+    ring.commit_write(std::min(wvec.size(), total - ring.total_written()));
+
+    const LargeRingBuffer::ReadVector rvec = ring.read_vector();
+    ring.commit_read(rvec.size());
+  }
+
+  assert(ring.total_written() == total);
+  assert(ring.total_read() == total);
+  assert(ring.read_space() == 0U);
+  assert(ring.write_space() == ring.capacity());
+
+  // The heads still map to the right place in the buffer
+  assert(ring.write(8U, "abcdefgh") == 8U);
+  const LargeRingBuffer::ReadVector vec = ring.read_vector();
+  assert(vec.first.size == 8U);
+  assert(vec.first.data == ring.write_vector().second.data + 3000U);
+
+  // Sizes that can't be rounded up to a power of two are rejected
+  bool caught = false;
+  try {
+    const LargeRingBuffer huge{(uint64_t{1U} << 63U) + 1U};
+  } catch (const std::length_error&) {
+    caught = true;
+  }
+  assert(caught);
+}
+
+void
+writer(LargeRingBuffer& ring)
+{
+  uint8_t msg[msg_size] = {};
+  for (uint32_t i = 0U; i < n_msgs;) {
+    memset(msg, static_cast<int>(i & 0xFFU), sizeof(msg));
+    if (ring.write(sizeof(msg), msg)) {
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+reader(LargeRingBuffer& ring)
+{
+  uint8_t msg[msg_size] = {};
+  for (uint32_t i = 0U; i < n_msgs;) {
+    if (!ring.read(sizeof(msg), msg)) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    for (uint32_t j = 0U; j < msg_size; ++j) {
+      assert(msg[j] == (i & 0xFFU));
+    }
+
+    ++i;
+  }
+}
+
+void
+test_threaded()
+{
+  LargeRingBuffer ring{4096U};
+
+  std::thread reader_thread(reader, std::ref(ring));
+  std::thread writer_thread(writer, std::ref(ring));
+
+  reader_thread.join();
+  writer_thread.join();
+
+  assert(ring.read_space() == 0U);
+  assert(ring.total_written() == uint64_t{n_msgs} * msg_size);
+  assert(ring.total_read() == ring.total_written());
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_large_totals();
+  test_threaded();
+  return 0;
+}
@@ -0,0 +1,137 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/LossyRingBuffer.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace {
+
+using LossyRingBuffer = raul::LossyRingBuffer;
+
+constexpr uint32_t n_msgs = 1U << 16U;
+
+void
+test_single_threaded()
+{
+  LossyRingBuffer ring{64U};
+  assert(ring.capacity() == 56U);
+
+  char buf[64] = {};
+  assert(!ring.read(sizeof(buf), buf));
+  assert(!ring.write(57U, buf));
+  assert(!ring.write(0U, buf));
+
+  // Write and read some messages normally
+  assert(ring.write(5U, "hello"));
+  assert(ring.write(9U, "123456789"));
+  assert(ring.read(sizeof(buf), buf) == 5U);
+  assert(!strncmp(buf, "hello", 5U));
+  assert(ring.read(sizeof(buf), buf) == 9U);
+  assert(!strncmp(buf, "123456789", 9U));
+  assert(!ring.read(sizeof(buf), buf));
+  assert(!ring.lost());
+
+  // Overflow, so the oldest messages (of 2 words each) are dropped
+  for (char c = 'a'; c < 'a' + 10; ++c) {
+    assert(ring.write(1U, &c));
+  }
+
+  for (char c = 'g'; c < 'a' + 10; ++c) {
+    assert(ring.read(sizeof(buf), buf) == 1U);
+    assert(buf[0] == c);
+  }
+
+  assert(!ring.read(sizeof(buf), buf));
+  assert(ring.lost() == 6U);
+
+  // Large messages drop several small ones
+  assert(ring.write(1U, "x"));
+  assert(ring.write(1U, "y"));
+  assert(ring.write(56U, buf));
+  assert(ring.read(sizeof(buf), buf) == 56U);
+  assert(ring.lost() == 8U);
+
+  // Messages larger than the reader's buffer are skipped
+  assert(ring.write(16U, "0123456789abcdef"));
+  assert(ring.write(2U, "ok"));
+  assert(ring.read(8U, buf) == 2U);
+  assert(!strncmp(buf, "ok", 2U));
+  assert(ring.lost() == 9U);
+}
+
+void
+writer(LossyRingBuffer& ring)
+{
+  uint32_t msg[8] = {};
+  for (uint32_t i = 0U; i < n_msgs; ++i) {
+    const uint32_t n_words = 1U + (i % 8U);
+    for (uint32_t j = 0U; j < n_words; ++j) {
+      msg[j] = i;
+    }
+
+    assert(ring.write(n_words * sizeof(uint32_t), msg));
+    if (!(i % 64U)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+reader(LossyRingBuffer& ring, std::atomic<bool>& done)
+{
+  uint32_t n_read = 0U;
+  uint32_t last   = 0U;
+  uint32_t msg[8] = {};
+  for (;;) {
+    const bool     finished = done.load(std::memory_order_acquire);
+    const uint32_t size     = ring.read(sizeof(msg), msg);
+    if (size) {
+      // Messages are never torn, and arrive in order
+      assert(size == (1U + (msg[0] % 8U)) * sizeof(uint32_t));
+      for (uint32_t j = 0U; j < size / sizeof(uint32_t); ++j) {
+        assert(msg[j] == msg[0]);
+      }
+
+      assert(!n_read || msg[0] > last);
+      last = msg[0];
+      ++n_read;
+    } else if (finished) {
+      break;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  assert(n_read + ring.lost() == n_msgs);
+}
+
+void
+test_threaded()
+{
+  LossyRingBuffer   ring{256U};
+  std::atomic<bool> done{false};
+
+  std::thread reader_thread(reader, std::ref(ring), std::ref(done));
+
+  writer(ring);
+  done.store(true, std::memory_order_release);
+  reader_thread.join();
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_threaded();
+  return 0;
+}
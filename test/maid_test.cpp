@@ -1,4 +1,4 @@
-// Copyright 2007-2017 David Robillard <d@drobilla.net>
+// Copyright 2007-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #undef NDEBUG
@@ -9,6 +9,7 @@
 #include <cassert>
 #include <chrono>
 #include <cstdio>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -44,6 +45,18 @@ private:
   size_t _val;
 };
 
+/// A plain type that doesn't inherit from Disposable
+struct Plain {
+  Plain() { ++n_junk; }
+
+  Plain(const Plain&)            = delete;
+  Plain& operator=(const Plain&) = delete;
+  Plain(Plain&&)                 = delete;
+  Plain& operator=(Plain&&)      = delete;
+
+  ~Plain() { --n_junk; }
+};
+
 void
 litter(Maid* maid)
 {
@@ -125,6 +138,440 @@ test()
   assert(n_junk == 1);
 }
 
+void
+test_many_threads()
+{
+  // Use more threads than there are lists, so some threads share a list
+  constexpr size_t n_disposers  = 40U;
+  constexpr size_t n_per_thread = 1U << 10U;
+
+  Maid                     maid;
+  std::atomic<bool>        done{false};
+  std::vector<std::thread> disposers;
+  disposers.reserve(n_disposers);
+  for (size_t i = 0; i < n_disposers; ++i) {
+    disposers.emplace_back([&maid] {
+      for (size_t j = 0; j < n_per_thread; ++j) {
+        maid.dispose(new Junk(j));
+      }
+    });
+  }
+
+  // Clean up in another thread, and here, so some cleanup() calls overlap
+  std::thread cleaner{[&maid, &done] {
+    while (!done) {
+      maid.cleanup();
+      std::this_thread::yield();
+    }
+  }};
+
+  for (auto& t : disposers) {
+    maid.cleanup();
+    t.join();
+  }
+
+  done = true;
+  cleaner.join();
+
+  maid.cleanup();
+  assert(maid.empty());
+  assert(n_junk == 0);
+}
+
+void
+wait_for_no_junk()
+{
+  const auto deadline =
+    std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+  while (n_junk && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  assert(n_junk == 0);
+}
+
+void
+test_batches()
+{
+  Maid maid;
+  for (size_t i = 0; i < 10U; ++i) {
+    maid.dispose(new Junk(i));
+  }
+
+  assert(maid.cleanup(4U) == 4U);
+  assert(n_junk == 6U);
+  assert(maid.cleanup(4U) == 4U);
+  assert(n_junk == 2U);
+  assert(maid.cleanup(4U) == 2U);
+  assert(!maid.cleanup(4U));
+  assert(maid.empty());
+
+  // Single-object batches eventually clean up every thread's garbage
+  std::thread other{[&maid] {
+    for (size_t i = 0; i < 4U; ++i) {
+      maid.dispose(new Junk(i));
+    }
+  }};
+
+  other.join();
+  for (size_t i = 0; i < 4U; ++i) {
+    maid.dispose(new Junk(i));
+  }
+
+  while (!maid.empty()) {
+    assert(maid.cleanup(1U) == 1U);
+  }
+
+  assert(n_junk == 0);
+}
+
+/// An object that blocks cleanup() while it's being deleted
+class Blocker : public Maid::Disposable
+{
+public:
+  Blocker(std::atomic<bool>& entered, std::atomic<bool>& unblock)
+    : _entered{entered}
+    , _unblock{unblock}
+  {}
+
+  Blocker(const Blocker&)            = delete;
+  Blocker& operator=(const Blocker&) = delete;
+  Blocker(Blocker&&)                 = delete;
+  Blocker& operator=(Blocker&&)      = delete;
+
+  ~Blocker() override
+  {
+    _entered = true;
+    while (!_unblock) {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  std::atomic<bool>& _entered;
+  std::atomic<bool>& _unblock;
+};
+
+void
+test_concurrent_cleanup()
+{
+  Maid              maid;
+  std::atomic<bool> entered{false};
+  std::atomic<bool> unblock{false};
+
+  // Start cleaning up in another thread, which gets stuck on the blocker
+  maid.dispose(new Blocker{entered, unblock});
+  std::thread cleaner{[&maid] { maid.cleanup(); }};
+  while (!entered) {
+    std::this_thread::yield();
+  }
+
+  // Trying to clean up leaves the work to the other thread
+  maid.dispose(new Junk(1U));
+  assert(!maid.try_cleanup());
+  assert(n_junk == 1U);
+
+  // Cleaning up waits for the other thread, then deletes everything
+  std::thread unblocker{[&unblock] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    unblock = true;
+  }};
+
+  maid.cleanup();
+  assert(n_junk == 0U);
+  assert(maid.empty());
+
+  unblocker.join();
+  cleaner.join();
+}
+
+void
+test_collector()
+{
+  Maid maid;
+
+  // Periodic collection in small batches
+  Maid::CollectorOptions options;
+  options.period     = std::chrono::milliseconds(1);
+  options.batch_size = 16U;
+  maid.start_collector(options);
+  for (size_t i = 0; i < 100U; ++i) {
+    maid.dispose(new Junk(i));
+  }
+
+  wait_for_no_junk();
+  maid.stop_collector();
+  maid.stop_collector(); // Mustn't crash
+
+  // Waking up early when the threshold is reached
+  options.period    = std::chrono::hours(1);
+  options.threshold = 8U;
+  maid.start_collector(options);
+  for (size_t i = 0; i < 8U; ++i) {
+    maid.dispose(new Junk(i));
+  }
+
+  wait_for_no_junk();
+
+  // Restarting, then destroying the Maid with the collector running
+  maid.start_collector();
+  maid.dispose(new Junk(0U));
+}
+
+void
+test_hazards()
+{
+  Maid               maid;
+  std::atomic<Junk*> shared{new Junk(1U)};
+
+  // A protected object isn't deleted until it is no longer protected
+  {
+    Maid::Hazard hazard{maid};
+    const Junk*  protected_junk = hazard.protect(shared);
+    assert(protected_junk->value() == 1U);
+
+    maid.dispose(shared.exchange(new Junk(2U)));
+    maid.dispose(new Junk(3U));
+    maid.cleanup();
+    assert(n_junk == 2U);
+    assert(!maid.empty());
+    assert(protected_junk->value() == 1U);
+
+    hazard.reset();
+    maid.cleanup();
+    assert(n_junk == 1U);
+    assert(maid.empty());
+
+    // Destroying the hazard also releases its protection
+    protected_junk = hazard.protect(shared);
+    maid.dispose(shared.exchange(new Junk(4U)));
+    maid.cleanup();
+    assert(n_junk == 2U);
+  }
+
+  maid.cleanup();
+  assert(n_junk == 1U);
+
+  // Readers hold onto objects while the writer replaces and disposes them
+  std::atomic<bool>        done{false};
+  std::vector<std::thread> readers;
+  for (size_t i = 0U; i < 2U; ++i) {
+    readers.emplace_back([&maid, &shared, &done] {
+      Maid::Hazard hazard{maid};
+      size_t       last = 0U;
+      while (!done) {
+        const Junk* const junk = hazard.protect(shared);
+        assert(junk->value() >= last);
+        last = junk->value();
+        std::this_thread::yield();
+        assert(junk->value() == last);
+      }
+    });
+  }
+
+  for (size_t i = 5U; i < 5U + (1U << 12U); ++i) {
+    maid.dispose(shared.exchange(new Junk(i)));
+    if (i % 16U == 0U) {
+      maid.cleanup();
+      std::this_thread::yield();
+    }
+  }
+
+  done = true;
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  maid.dispose(shared.exchange(nullptr));
+}
+
+void
+test_any_type()
+{
+  Maid maid{3U};
+
+  // Objects of any type can be disposed with a raw or unique pointer
+  assert(maid.dispose(new Plain{}));
+  assert(maid.dispose(std::make_unique<Plain>()));
+  assert(maid.dispose(std::make_unique<Plain[]>(4U)));
+  assert(n_junk == 6U);
+
+  // Which fails without taking ownership when every node is in use
+  auto* const plain = new Plain{};
+  assert(!maid.dispose(plain));
+  auto owned = std::make_unique<Plain>();
+  assert(!maid.dispose(std::move(owned)));
+  assert(owned);
+  assert(n_junk == 8U);
+
+  // Disposable objects don't need a node
+  assert(maid.dispose(std::make_unique<Junk>(1U)));
+  assert(n_junk == 9U);
+
+  // Cleaning up deletes the objects and frees their nodes
+  maid.cleanup();
+  assert(n_junk == 2U);
+  assert(maid.empty());
+  assert(maid.dispose(plain));
+  assert(maid.dispose(std::move(owned)));
+  assert(!owned);
+
+  // Arrays like buffers are disposed as unique pointers to use delete[]
+  std::unique_ptr<float[]> buffer{new float[512]};
+  assert(maid.dispose(std::move(buffer)));
+  assert(!buffer);
+
+  // A Maid without nodes can't dispose of arbitrary objects
+  Maid plain_maid;
+  owned = std::make_unique<Plain>();
+  assert(!plain_maid.dispose(std::move(owned)));
+  owned.reset();
+  assert(n_junk == 2U);
+}
+
+void
+test_shared()
+{
+  Maid maid;
+
+  // Shared objects are disposed of when the last reference is dropped
+  {
+    Maid::managed_shared_ptr<Junk> a = maid.make_managed_shared<Junk>(1U);
+    assert(a->value() == 1U);
+    assert(a.use_count() == 1U);
+    assert(n_junk == 1U);
+
+    Maid::managed_shared_ptr<Junk> b = a;
+    assert(b.get() == a.get());
+    assert(a.use_count() == 2U);
+
+    Maid::managed_shared_ptr<Junk> c = std::move(a);
+    assert(!a);
+    assert(!a.use_count());
+    assert(c.use_count() == 2U);
+
+    b.reset();
+    assert(c.use_count() == 1U);
+    maid.cleanup();
+    assert(n_junk == 1U);
+  }
+
+  assert(n_junk == 1U);
+  assert(!maid.empty());
+  maid.cleanup();
+  assert(n_junk == 0U);
+
+  // Objects of any type can be shared, and converted to a base type
+  {
+    const Maid::managed_shared_ptr<Plain> plain =
+      maid.make_managed_shared<Plain>();
+
+    const Maid::managed_shared_ptr<const Plain> const_plain = plain;
+    assert(const_plain.get() == plain.get());
+    assert(plain.use_count() == 2U);
+  }
+
+  maid.cleanup();
+  assert(n_junk == 0U);
+
+  // References can be dropped in any thread
+  Maid::managed_shared_ptr<Junk> shared = maid.make_managed_shared<Junk>(2U);
+  std::vector<std::thread> threads;
+  for (size_t i = 0U; i < 4U; ++i) {
+    threads.emplace_back([ref = shared] {
+      for (size_t j = 0U; j < 1024U; ++j) {
+        Maid::managed_shared_ptr<Junk> copy = ref;
+        assert(copy->value() == 2U);
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  shared = nullptr;
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  assert(n_junk == 1U);
+  maid.cleanup();
+  assert(n_junk == 0U);
+}
+
+void
+test_stats()
+{
+  // Statistics don't make objects any larger
+  static_assert(sizeof(Maid::Disposable) <= 2U * sizeof(void*));
+
+  Maid maid{1U};
+
+  Maid::Stats stats = maid.stats();
+  assert(!stats.n_disposed);
+  assert(!stats.n_freed);
+  assert(!stats.backlog);
+  assert(!stats.peak_backlog);
+  assert(!stats.backlog_bytes);
+  assert(!stats.max_latency.count());
+
+  // Mark the start of the interval that the next objects are disposed in
+  const auto start = std::chrono::steady_clock::now();
+  maid.cleanup();
+
+  // Disposed objects are counted along with their size if it's known,
+  // which is used to estimate the size of the backlog
+  {
+    const Maid::managed_ptr<Junk> a = maid.make_managed<Junk>(1U);
+    const Maid::managed_ptr<Junk> b = maid.make_managed<Junk>(2U);
+  }
+
+  maid.dispose(new Junk(3U));
+  assert(maid.dispose(std::make_unique<Plain>()));
+
+  stats = maid.stats();
+  assert(stats.n_disposed == 4U);
+  assert(!stats.n_freed);
+  assert(stats.backlog == 4U);
+  assert(stats.peak_backlog == 4U);
+  assert(stats.backlog_bytes > 2U * sizeof(Junk) + sizeof(Plain));
+
+  // Deleted objects are counted along with an estimate of how long they
+  // waited, which is bounded by the time between cleanups
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  maid.cleanup();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  stats              = maid.stats();
+  assert(stats.n_disposed == 4U);
+  assert(stats.n_freed == 4U);
+  assert(!stats.backlog);
+  assert(stats.peak_backlog == 4U);
+  assert(!stats.backlog_bytes);
+  assert(stats.max_latency >= std::chrono::milliseconds(2));
+  assert(stats.max_latency <= elapsed);
+  assert(stats.mean_latency >= std::chrono::milliseconds(1));
+  assert(stats.mean_latency <= stats.max_latency);
+
+  // Protected objects are still counted as waiting
+  std::atomic<Junk*> shared{new Junk(4U)};
+  {
+    Maid::Hazard hazard{maid};
+    hazard.protect(shared);
+    maid.dispose(shared.exchange(nullptr), sizeof(Junk));
+    maid.cleanup();
+    stats = maid.stats();
+    assert(stats.n_disposed == 5U);
+    assert(stats.n_freed == 4U);
+    assert(stats.backlog == 1U);
+    assert(stats.backlog_bytes > 0U);
+  }
+
+  maid.cleanup();
+  stats = maid.stats();
+  assert(stats.n_freed == 5U);
+  assert(!stats.backlog);
+  assert(stats.peak_backlog == 4U);
+}
+
 } // namespace
 
 int
@@ -133,5 +580,21 @@ main()
   assert(n_junk == 0);
   test();
   assert(n_junk == 0);
+  test_many_threads();
+  assert(n_junk == 0);
+  test_batches();
+  assert(n_junk == 0);
+  test_concurrent_cleanup();
+  assert(n_junk == 0);
+  test_collector();
+  assert(n_junk == 0);
+  test_hazards();
+  assert(n_junk == 0);
+  test_any_type();
+  assert(n_junk == 0);
+  test_shared();
+  assert(n_junk == 0);
+  test_stats();
+  assert(n_junk == 0);
   return 0;
 }
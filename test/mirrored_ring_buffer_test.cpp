@@ -0,0 +1,142 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/MirroredRingBuffer.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using MirroredRingBuffer = raul::MirroredRingBuffer;
+
+constexpr uint32_t n_msgs   = 1U << 16U;
+constexpr uint32_t msg_size = 100U;
+
+void
+test_single_threaded()
+{
+  MirroredRingBuffer ring{16U};
+  const uint32_t     size = ring.capacity();
+  assert(size >= 16U);
+  assert(ring.write_space() == size);
+  assert(ring.read_space() == 0U);
+
+  char buf[8] = {};
+  assert(!ring.read(1U, buf));
+  assert(!ring.skip(1U));
+
+  // Move the heads to just before the end
+  assert(ring.write_vector().size() == size);
+  ring.commit_write(size - 4U);
+  assert(ring.skip(size - 4U) == size - 4U);
+
+  // Write across the end, which is a single contiguous region
+  const MirroredRingBuffer::WriteVector wvec = ring.write_vector();
+  assert(wvec.first.size == size);
+  assert(wvec.second.size == 0U);
+  assert(ring.write(8U, "abcdefgh") == 8U);
+
+  // The wrapped part is visible at the start of the first mapping too
+  const MirroredRingBuffer::ReadVector rvec = ring.read_vector();
+  assert(rvec.first.size == 8U);
+  assert(rvec.second.size == 0U);
+  assert(!strncmp(rvec.first.data, "abcdefgh", 8U));
+  assert(!strncmp(rvec.first.data - (size - 4U), "efgh", 4U));
+
+  assert(ring.peek(4U, buf) == 4U);
+  assert(!strncmp(buf, "abcd", 4U));
+  assert(ring.read(8U, buf) == 8U);
+  assert(!strncmp(buf, "abcdefgh", 8U));
+  assert(ring.read_space() == 0U);
+
+  // Fill completely
+  for (uint32_t i = 0U; i < size; ++i) {
+    assert(ring.write(1U, "X") == 1U);
+  }
+  assert(ring.write_space() == 0U);
+  assert(!ring.write(1U, "Y"));
+
+  ring.reset();
+  assert(ring.read_space() == 0U);
+  assert(ring.write_space() == size);
+}
+
+void
+writer(MirroredRingBuffer& ring)
+{
+  uint8_t msg[msg_size] = {};
+  for (uint32_t i = 0U; i < n_msgs;) {
+    memset(msg, static_cast<int>(i & 0xFFU), sizeof(msg));
+    if (ring.write(sizeof(msg), msg)) {
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+reader(MirroredRingBuffer& ring)
+{
+  for (uint32_t i = 0U; i < n_msgs;) {
+    const MirroredRingBuffer::ReadVector vec = ring.read_vector();
+    if (vec.first.size < msg_size) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    // Parse in place, since messages are always contiguous
+    for (uint32_t j = 0U; j < msg_size; ++j) {
+      assert(static_cast<uint8_t>(vec.first.data[j]) == (i & 0xFFU));
+    }
+
+    ring.commit_read(msg_size);
+    ++i;
+  }
+}
+
+void
+test_threaded()
+{
+  MirroredRingBuffer ring{4096U};
+
+  std::thread reader_thread(reader, std::ref(ring));
+  std::thread writer_thread(writer, std::ref(ring));
+
+  reader_thread.join();
+  writer_thread.join();
+
+  assert(ring.read_space() == 0U);
+}
+
+void
+test_too_large()
+{
+  // Sizes that can't be rounded up to a power of two are rejected
+  bool caught = false;
+  try {
+    const MirroredRingBuffer ring{(1U << 31U) + 1U};
+  } catch (const std::length_error&) {
+    caught = true;
+  }
+
+  assert(caught);
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_threaded();
+  test_too_large();
+  return 0;
+}
@@ -0,0 +1,239 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/MpmcQueue.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t n_threads         = 4U;
+constexpr size_t n_jobs_per_thread = 1U << 15U;
+constexpr size_t max_batch_size    = 7U;
+
+std::atomic<size_t> n_live_jobs{0U};
+std::atomic<size_t> n_moved_jobs{0U};
+
+class Job
+{
+public:
+  explicit Job(size_t id = 0U) noexcept
+    : _id{id}
+  {
+    ++n_live_jobs;
+  }
+
+  Job(const Job& job)
+    : _id{job._id}
+  {
+    ++n_live_jobs;
+  }
+
+  Job(Job&& job) noexcept
+    : _id{job._id}
+  {
+    ++n_live_jobs;
+    ++n_moved_jobs;
+  }
+
+  Job& operator=(const Job&) = default;
+  Job& operator=(Job&&)      = default;
+
+  ~Job() { --n_live_jobs; }
+
+  [[nodiscard]] size_t id() const { return _id; }
+
+private:
+  size_t _id;
+};
+
+/// An element with a constructor that may throw
+struct Picky {
+  explicit Picky(int v)
+    : value{v}
+  {
+    if (v < 0) {
+      throw std::invalid_argument{"Negative value"};
+    }
+  }
+
+  int value;
+};
+
+void
+test_single_threaded()
+{
+  {
+    raul::MpmcQueue<Job> queue{3U};
+    assert(queue.capacity() == 4U);
+    assert(queue.size() == 0U);
+
+    Job job{};
+    assert(!queue.try_pop(job));
+
+    // Push until full
+    assert(queue.try_push(Job{1U}));
+
+    // Emplacing constructs the element in the queue without moving it
+    const size_t n_moved = n_moved_jobs;
+    assert(queue.try_emplace(2U));
+    assert(n_moved_jobs == n_moved);
+
+    const Job three{3U};
+    assert(queue.try_push(three));
+    assert(queue.try_emplace(4U));
+    assert(!queue.try_emplace(5U));
+    assert(queue.size() == 4U);
+
+    // Pop in order
+    assert(queue.try_pop(job));
+    assert(job.id() == 1U);
+
+    // Empty batches do nothing, even if the queue isn't full or empty
+    assert(!queue.try_push_n(&job, 0U));
+    assert(!queue.try_pop_n(&job, 0U));
+    assert(queue.size() == 3U);
+
+    // Batch push with partial success
+    Job batch[3] = {Job{6U}, Job{7U}, Job{8U}};
+    assert(queue.try_push_n(batch, 3U) == 1U);
+
+    // Batch pop everything
+    Job out[8];
+    assert(queue.try_pop_n(out, 8U) == 4U);
+    assert(out[0].id() == 2U);
+    assert(out[1].id() == 3U);
+    assert(out[2].id() == 4U);
+    assert(out[3].id() == 6U);
+    assert(queue.size() == 0U);
+
+    // Leave some elements in the queue to be destroyed with it
+    assert(queue.try_emplace(9U));
+    assert(queue.try_emplace(10U));
+  }
+
+  assert(n_live_jobs == 0U);
+
+  // Move-only types work too
+  raul::MpmcQueue<std::unique_ptr<int>> queue{4U};
+  assert(queue.try_push(std::make_unique<int>(42)));
+
+  std::unique_ptr<int> ptr;
+  assert(queue.try_pop(ptr));
+  assert(*ptr == 42);
+
+  // A throwing constructor doesn't leave a claimed but empty cell behind
+  raul::MpmcQueue<Picky> picky_queue{2U};
+  bool                   caught = false;
+  try {
+    picky_queue.try_emplace(-1);
+  } catch (const std::invalid_argument&) {
+    caught = true;
+  }
+
+  assert(caught);
+  assert(!picky_queue.size());
+  assert(picky_queue.try_emplace(1));
+
+  Picky picky{0};
+  assert(picky_queue.try_pop(picky));
+  assert(picky.value == 1);
+}
+
+void
+producer(raul::MpmcQueue<size_t>& queue, const size_t id)
+{
+  size_t batch[max_batch_size];
+  size_t next = 0U;
+  while (next < n_jobs_per_thread) {
+    // Push in batches of various sizes
+    size_t n = 0U;
+    for (; n < 1U + next % max_batch_size && next + n < n_jobs_per_thread;
+         ++n) {
+      batch[n] = id * n_jobs_per_thread + next + n;
+    }
+
+    const size_t n_pushed = queue.try_push_n(batch, n);
+    if (!n_pushed) {
+      std::this_thread::yield();
+    }
+
+    next += n_pushed;
+  }
+}
+
+void
+consumer(raul::MpmcQueue<size_t>& queue,
+         std::atomic<size_t>&     n_popped,
+         std::vector<size_t>&     popped)
+{
+  size_t batch[max_batch_size];
+  while (n_popped < n_threads * n_jobs_per_thread) {
+    const size_t n = queue.try_pop_n(batch, 1U + popped.size() % 3U);
+    if (!n) {
+      std::this_thread::yield();
+    }
+
+    for (size_t i = 0U; i < n; ++i) {
+      popped.push_back(batch[i]);
+    }
+
+    n_popped += n;
+  }
+}
+
+void
+test_threaded()
+{
+  raul::MpmcQueue<size_t> queue{64U};
+
+  std::atomic<size_t>              n_popped{0U};
+  std::vector<std::vector<size_t>> popped(n_threads);
+  std::vector<std::thread>         threads;
+  threads.reserve(2U * n_threads);
+  for (size_t i = 0U; i < n_threads; ++i) {
+    threads.emplace_back(producer, std::ref(queue), i);
+    threads.emplace_back(
+      consumer, std::ref(queue), std::ref(n_popped), std::ref(popped[i]));
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Check that every job was popped exactly once, in order per producer
+  std::vector<bool> seen(n_threads * n_jobs_per_thread);
+  for (const auto& values : popped) {
+    std::vector<size_t> last(n_threads, 0U);
+    for (const size_t v : values) {
+      const size_t producer_id = v / n_jobs_per_thread;
+      assert(!seen[v]);
+      assert(!last[producer_id] || v > last[producer_id]);
+      seen[v]           = true;
+      last[producer_id] = v;
+    }
+  }
+
+  for (const bool s : seen) {
+    assert(s);
+  }
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_threaded();
+  return 0;
+}
@@ -0,0 +1,156 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/MpscRingBuffer.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using MpscRingBuffer = raul::MpscRingBuffer;
+
+constexpr uint32_t n_writers           = 4U;
+constexpr uint32_t n_msgs_per_writer   = 1U << 15U;
+constexpr uint32_t max_msg_payload_len = 13U;
+
+struct Message {
+  uint32_t writer;
+  uint32_t seq;
+  char     payload[max_msg_payload_len];
+};
+
+void
+test_single_threaded()
+{
+  MpscRingBuffer ring{64U};
+  char           buf[64] = {};
+
+  assert(ring.capacity() == 64U);
+  assert(ring.write_space() == 64U);
+  assert(!ring.peek_size());
+  assert(!ring.read(sizeof(buf), buf));
+  assert(!ring.skip());
+  assert(!ring.write(0U, buf));
+
+  // Write and read a message
+  assert(ring.write(5U, "hello") == 5U);
+  assert(ring.write_space() == 56U);
+  assert(ring.peek_size() == 5U);
+  assert(!ring.read(4U, buf)); // Too small
+  assert(ring.read(sizeof(buf), buf) == 5U);
+  assert(!strncmp(buf, "hello", 5U));
+  assert(ring.write_space() == 64U);
+
+  // Fill the ring with 16-byte messages, wrapping around the end
+  uint32_t n_written = 0U;
+  char     msg[16]   = {};
+  while (ring.write(sizeof(msg), msg)) {
+    ++n_written;
+  }
+  assert(n_written == 4U);
+  assert(ring.write_space() == 0U);
+
+  // Read them all back
+  while (ring.skip()) {
+    --n_written;
+  }
+  assert(n_written == 0U);
+
+  // Messages that don't fit can never be written
+  char big[128] = {};
+  assert(!ring.write(sizeof(big), big));
+
+  ring.reset();
+  assert(!ring.peek_size());
+  assert(ring.write_space() == 64U);
+}
+
+void
+writer(MpscRingBuffer& ring, const uint32_t id)
+{
+  Message msg{id, 0U, {}};
+  while (msg.seq < n_msgs_per_writer) {
+    const uint32_t len = msg.seq % max_msg_payload_len;
+    memset(msg.payload, static_cast<int>('a' + id), len);
+    if (ring.write(uint32_t{offsetof(Message, payload)} + len, &msg)) {
+      ++msg.seq;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+test_threaded()
+{
+  MpscRingBuffer ring{512U};
+
+  std::vector<std::thread> writers;
+  writers.reserve(n_writers);
+  for (uint32_t i = 0U; i < n_writers; ++i) {
+    writers.emplace_back(writer, std::ref(ring), i);
+  }
+
+  // Read every message, checking that each writer's messages are in order
+  std::vector<uint32_t> next_seqs(n_writers, 0U);
+  uint32_t              n_read = 0U;
+  while (n_read < n_writers * n_msgs_per_writer) {
+    Message        msg{};
+    const uint32_t size = ring.read(sizeof(msg), &msg);
+    if (size) {
+      assert(msg.writer < n_writers);
+      assert(msg.seq == next_seqs[msg.writer]);
+
+      const uint32_t len = msg.seq % max_msg_payload_len;
+      assert(size == offsetof(Message, payload) + len);
+      for (uint32_t i = 0U; i < len; ++i) {
+        assert(msg.payload[i] == static_cast<char>('a' + msg.writer));
+      }
+
+      ++next_seqs[msg.writer];
+      ++n_read;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  for (auto& t : writers) {
+    t.join();
+  }
+
+  assert(!ring.peek_size());
+}
+
+void
+test_too_large()
+{
+  // Sizes that can't be rounded up to a power of two are rejected
+  bool caught = false;
+  try {
+    const MpscRingBuffer ring{(1U << 31U) + 1U};
+  } catch (const std::length_error&) {
+    caught = true;
+  }
+
+  assert(caught);
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_threaded();
+  test_too_large();
+  return 0;
+}
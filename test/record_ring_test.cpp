@@ -0,0 +1,221 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/RecordRing.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace {
+
+using RecordRing = raul::RecordRing;
+
+constexpr uint32_t n_records = 1U << 16U;
+
+void
+test_single_threaded()
+{
+  RecordRing          ring{64U};
+  RecordRing::Header  header{};
+  char                buf[32] = {};
+  const char* const   msg     = "hello";
+  const uint32_t      msg_len = 5U;
+
+  assert(!ring.peek_header(header));
+  assert(!ring.read(header, sizeof(buf), buf));
+  assert(!ring.skip());
+
+  // Write and read a single record
+  assert(ring.write(1U, msg_len, msg));
+  assert(ring.peek_header(header));
+  assert(header.type == 1U);
+  assert(header.size == msg_len);
+  assert(!ring.read(header, msg_len - 1U, buf)); // Too small
+  assert(ring.read(header, sizeof(buf), buf));
+  assert(header.type == 1U);
+  assert(header.size == msg_len);
+  assert(!strncmp(buf, msg, msg_len));
+  assert(!ring.peek_header(header));
+
+  // Empty bodies are allowed
+  assert(ring.write(2U, 0U, nullptr));
+  assert(ring.read(header, 0U, nullptr));
+  assert(header.type == 2U);
+  assert(header.size == 0U);
+
+  // Fill the ring until a write fails (records here are 16 bytes)
+  uint32_t n_written = 0U;
+  while (ring.write(3U, sizeof(n_written), &n_written)) {
+    ++n_written;
+  }
+  assert(n_written >= 2U);
+
+  // Read one record so the next wraps around the end, which needs padding
+  uint32_t value = 0U;
+  assert(ring.read(header, sizeof(value), &value));
+  assert(header.type == 3U);
+  assert(value == 0U);
+  assert(ring.write(4U, sizeof(value), &value));
+
+  // Check that everything is read back in order and contiguous
+  for (uint32_t i = 1U; i < n_written; ++i) {
+    const void* const body = ring.peek(header);
+    assert(body);
+    assert(header.type == 3U);
+    memcpy(&value, body, sizeof(value));
+    assert(value == i);
+    assert(ring.skip());
+  }
+
+  assert(ring.read(header, sizeof(value), &value));
+  assert(header.type == 4U);
+  assert(!ring.peek_header(header));
+
+  // Records larger than the ring can never be written
+  char big[128] = {};
+  assert(!ring.write(5U, sizeof(big), big));
+
+  // Records up to half the ring can be written wherever the heads are
+  assert(ring.max_size() == 24U);
+  for (uint32_t i = 0U; i < 16U; ++i) {
+    assert(ring.write(6U, ring.max_size(), big));
+    assert(ring.read(header, sizeof(big), big));
+    assert(header.size == ring.max_size());
+    assert(ring.write(7U, i % 3U, big));
+    assert(ring.skip());
+  }
+
+  // But larger records are rejected, even if they would happen to fit now
+  assert(!ring.write(5U, ring.max_size() + 1U, big));
+  ring.reset();
+  assert(!ring.write(5U, ring.max_size() + 1U, big));
+}
+
+void
+test_consume()
+{
+  RecordRing         ring{64U};
+  RecordRing::Header header{};
+  uint32_t           value = 0U;
+
+  const auto fail = [](const RecordRing::Header&, const void*) {
+    assert(false);
+  };
+
+  assert(!ring.consume(fail));
+
+  // Write 3 records (16 bytes each), consume 2, then write 2 more which wraps
+  for (value = 0U; value < 3U; ++value) {
+    assert(ring.write(1U, sizeof(value), &value));
+  }
+
+  uint32_t next = 0U;
+
+  const auto check = [&next](const RecordRing::Header& h, const void* body) {
+    uint32_t v = 0U;
+    assert(h.type == 1U);
+    assert(h.size == sizeof(v));
+    memcpy(&v, body, sizeof(v));
+    assert(v == next++);
+  };
+
+  assert(ring.consume(check, 2U) == 2U);
+  assert(next == 2U);
+  for (; value < 5U; ++value) {
+    assert(ring.write(1U, sizeof(value), &value));
+  }
+
+  // Consume everything at once, across the padding and the end
+  assert(ring.consume(check) == 3U);
+  assert(next == 5U);
+  assert(!ring.peek_header(header));
+  assert(!ring.consume(fail));
+}
+
+void
+writer(RecordRing& ring)
+{
+  char body[64] = {};
+  for (uint32_t i = 0U; i < n_records;) {
+    const uint32_t size = i % sizeof(body);
+    memset(body, static_cast<int>(i & 0x7FU), size);
+    if (ring.write(i, size, body)) {
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+reader(RecordRing& ring)
+{
+  RecordRing::Header header{};
+  char               body[64] = {};
+  for (uint32_t i = 0U; i < n_records;) {
+    if (ring.read(header, sizeof(body), body)) {
+      assert(header.type == i);
+      assert(header.size == i % sizeof(body));
+      for (uint32_t j = 0U; j < header.size; ++j) {
+        assert(body[j] == static_cast<char>(i & 0x7FU));
+      }
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+batch_reader(RecordRing& ring)
+{
+  uint32_t i = 0U;
+
+  const auto check = [&i](const RecordRing::Header& header, const void* body) {
+    assert(header.type == i);
+    assert(header.size == i % 64U);
+    const auto* const bytes = static_cast<const char*>(body);
+    for (uint32_t j = 0U; j < header.size; ++j) {
+      assert(bytes[j] == static_cast<char>(i & 0x7FU));
+    }
+    ++i;
+  };
+
+  while (i < n_records) {
+    if (!ring.consume(check)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+test_threaded(void (*read_all)(RecordRing&))
+{
+  RecordRing ring{256U};
+
+  std::thread reader_thread(read_all, std::ref(ring));
+  std::thread writer_thread(writer, std::ref(ring));
+
+  reader_thread.join();
+  writer_thread.join();
+
+  RecordRing::Header header{};
+  assert(!ring.peek_header(header));
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_consume();
+  test_threaded(reader);
+  test_threaded(batch_reader);
+  return 0;
+}
@@ -0,0 +1,145 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/Maid.hpp>
+#include <raul/Recycled.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class Voice
+  : public raul::Maid::Disposable
+  , public raul::Recycled<Voice>
+{
+public:
+  explicit Voice(int note)
+    : _note{note}
+  {}
+
+  [[nodiscard]] int note() const { return _note; }
+
+private:
+  int _note;
+};
+
+class BigVoice : public Voice
+{
+public:
+  explicit BigVoice(int note)
+    : Voice{note}
+  {}
+
+  char buffer[64]{};
+};
+
+void
+test_recycling()
+{
+  assert(!Voice::n_free());
+
+  // Deleted objects are recycled
+  auto* const voice = new Voice{60};
+  delete voice;
+  assert(Voice::n_free() == 1U);
+
+  auto* const reused = new Voice{61};
+  assert(reused == voice);
+  assert(reused->note() == 61);
+  assert(!Voice::n_free());
+  delete reused;
+
+  // Derived classes use the global allocator
+  auto* const big = new BigVoice{62};
+  delete big;
+  assert(Voice::n_free() == 1U);
+
+  // Trimming frees blocks, and reserving allocates them
+  Voice::trim();
+  assert(!Voice::n_free());
+  Voice::reserve(4U);
+  assert(Voice::n_free() == 4U);
+  Voice::trim(2U);
+  assert(Voice::n_free() == 2U);
+  Voice::trim();
+}
+
+void
+test_maid()
+{
+  raul::Maid maid;
+
+  // Objects deleted by the Maid are recycled by make_managed()
+  const Voice* first = nullptr;
+  {
+    const raul::managed_ptr<Voice> voice = maid.make_managed<Voice>(60);
+    first                                = voice.get();
+  }
+
+  assert(!Voice::n_free());
+  maid.cleanup();
+  assert(Voice::n_free() == 1U);
+
+  const raul::managed_ptr<Voice> voice = maid.make_managed<Voice>(61);
+  assert(voice.get() == first);
+  assert(!Voice::n_free());
+}
+
+void
+test_static()
+{
+  // A static Maid created before the pool deletes this after main returns,
+  // which is fine since the pool is never destroyed
+  static raul::Maid maid;
+  maid.dispose(new Voice{60});
+}
+
+void
+test_threaded()
+{
+  constexpr size_t n_threads = 4U;
+
+  Voice::reserve(n_threads * 8U);
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  for (size_t i = 0U; i < n_threads; ++i) {
+    threads.emplace_back([] {
+      Voice* voices[8] = {};
+      for (int j = 0; j < 1024; ++j) {
+        for (int k = 0; k < 8; ++k) {
+          voices[k] = new Voice{j + k};
+        }
+
+        for (int k = 0; k < 8; ++k) {
+          assert(voices[k]->note() == j + k);
+          delete voices[k];
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  assert(Voice::n_free() == n_threads * 8U);
+  Voice::trim();
+}
+
+} // namespace
+
+int
+main()
+{
+  test_static();
+  test_recycling();
+  test_maid();
+  test_threaded();
+  return 0;
+}
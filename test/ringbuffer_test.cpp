@@ -1,12 +1,15 @@
-// Copyright 2007-2019 David Robillard <d@drobilla.net>
+// Copyright 2007-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #undef NDEBUG
 
+#include <raul/AllocationPolicy.hpp>
 #include <raul/RingBuffer.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -14,6 +17,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
 
 constexpr const auto MSG_SIZE = 20U;
 
@@ -83,6 +87,186 @@ writer(Context& ctx)
   printf("Writer finished\n");
 }
 
+void
+test_vectors()
+{
+  RingBuffer ring{16U};
+
+  // Move the heads near the end so the vectors wrap around
+  char junk[12] = {};
+  assert(ring.write(sizeof(junk), junk) == sizeof(junk));
+  assert(ring.skip(sizeof(junk)) == sizeof(junk));
+
+  // Write directly into the ring, wrapping around the end
+  const RingBuffer::WriteVector wvec = ring.write_vector();
+  assert(wvec.size() == ring.capacity());
+  assert(wvec.first.size == 4U);
+  assert(wvec.second.size == ring.capacity() - 4U);
+  memcpy(wvec.first.data, "abcd", 4U);
+  memcpy(wvec.second.data, "efgh", 4U);
+  assert(ring.read_space() == 0U);
+  ring.commit_write(8U);
+  assert(ring.read_space() == 8U);
+
+  // Read directly from the ring
+  const RingBuffer::ReadVector rvec = ring.read_vector();
+  assert(rvec.size() == 8U);
+  assert(rvec.first.size == 4U);
+  assert(!strncmp(rvec.first.data, "abcd", 4U));
+  assert(rvec.second.size == 4U);
+  assert(!strncmp(rvec.second.data, "efgh", 4U));
+  ring.commit_read(2U);
+  assert(ring.read_space() == 6U);
+
+  // Copying read sees the same data
+  char buf[6] = {};
+  assert(ring.read(sizeof(buf), buf) == sizeof(buf));
+  assert(!strncmp(buf, "cdefgh", sizeof(buf)));
+  assert(ring.read_space() == 0U);
+  assert(ring.read_vector().size() == 0U);
+}
+
+void
+test_move()
+{
+  RingBuffer ring1{16U};
+  assert(ring1.write(4U, "move") == 4U);
+
+  RingBuffer ring2{std::move(ring1)};
+  assert(ring2.read_space() == 4U);
+
+  RingBuffer ring3{8U};
+  ring3 = std::move(ring2);
+
+  char buf[4] = {};
+  assert(ring3.read(sizeof(buf), buf) == sizeof(buf));
+  assert(!strncmp(buf, "move", sizeof(buf)));
+  assert(ring3.write_space() == ring3.capacity());
+}
+
+void
+test_consume()
+{
+  RingBuffer ring{16U};
+
+  const auto fail = [](const char*, uint32_t) -> uint32_t {
+    assert(false);
+    return 0U;
+  };
+
+  assert(!ring.consume(fail));
+
+  // Move the heads near the end so the data wraps around
+  char junk[12] = {};
+  assert(ring.write(sizeof(junk), junk) == sizeof(junk));
+  assert(ring.skip(sizeof(junk)) == sizeof(junk));
+  assert(ring.write(8U, "abcdefgh") == 8U);
+
+  // Consume only part of the first segment
+  std::string consumed;
+
+  const auto take = [&consumed](const size_t n) {
+    return [&consumed, n](const char* data, uint32_t size) -> uint32_t {
+      const auto count = static_cast<uint32_t>(std::min(size_t{size}, n));
+      consumed.append(data, count);
+      return count;
+    };
+  };
+
+  assert(ring.consume(take(2U)) == 2U);
+  assert(consumed == "ab");
+  assert(ring.read_space() == 6U);
+
+  // Consume everything, across the end
+  assert(ring.consume(take(SIZE_MAX)) == 6U);
+  assert(consumed == "abcdefgh");
+  assert(ring.read_space() == 0U);
+  assert(!ring.consume(fail));
+}
+
+void
+test_stats()
+{
+  RingBuffer ring{16U};
+
+  RingBuffer::Stats stats = ring.stats();
+  assert(!stats.bytes_written);
+  assert(!stats.bytes_read);
+  assert(!stats.failed_writes);
+  assert(!stats.failed_reads);
+  assert(!stats.high_water);
+
+  char buf[16] = {};
+  assert(!ring.read(1U, buf));
+  assert(!ring.peek(1U, buf));
+  assert(!ring.skip(1U));
+  assert(ring.write(10U, buf) == 10U);
+  assert(!ring.write(10U, buf));
+  assert(ring.read(4U, buf) == 4U);
+  assert(ring.skip(2U) == 2U);
+  assert(ring.write(10U, buf) == 10U);
+
+  stats = ring.stats();
+  assert(stats.bytes_written == 20U);
+  assert(stats.bytes_read == 6U);
+  assert(stats.failed_writes == 1U);
+  assert(stats.failed_reads == 3U);
+  assert(stats.high_water == 10U);
+
+  // Fill the ring completely
+  ring.commit_write(ring.write_vector().size());
+  assert(ring.stats().bytes_written == 21U);
+  assert(!ring.write(1U, buf));
+
+  // The high water mark is sampled when the reader next looks
+  assert(ring.stats().high_water == 10U);
+  assert(ring.read_vector().size() == ring.capacity());
+  assert(ring.stats().high_water == ring.capacity());
+
+  // The reader sees the exact peak whenever it reloads the write head
+  ring.reset();
+  ring.reset_stats();
+  assert(ring.write(9U, buf) == 9U);
+  assert(ring.read(9U, buf) == 9U);
+  assert(ring.stats().high_water == 9U);
+
+  // Reads from the cached view don't lower it
+  assert(ring.write(4U, buf) == 4U);
+  assert(ring.read(2U, buf) == 2U);
+  assert(ring.read(2U, buf) == 2U);
+  assert(ring.stats().high_water == 9U);
+
+  // Statistics move with the ring
+  RingBuffer moved{std::move(ring)};
+  assert(moved.stats().bytes_written == 13U);
+  assert(moved.stats().high_water == 9U);
+
+  moved.reset_stats();
+  stats = moved.stats();
+  assert(!stats.bytes_written);
+  assert(!stats.bytes_read);
+  assert(!stats.failed_writes);
+  assert(!stats.failed_reads);
+  assert(!stats.high_water);
+}
+
+void
+test_policies()
+{
+  for (const auto policy : {raul::AllocationPolicy::locked,
+                            raul::AllocationPolicy::huge}) {
+    RingBuffer ring1{16U, policy};
+    assert(ring1.capacity() == 15U);
+    assert(ring1.write(4U, "lock") == 4U);
+
+    // Moving transfers ownership along with the policy
+    RingBuffer ring2{std::move(ring1)};
+    char       buf[4] = {};
+    assert(ring2.read(sizeof(buf), buf) == sizeof(buf));
+    assert(!strncmp(buf, "lock", sizeof(buf)));
+  }
+}
+
 } // namespace
 
 int
@@ -141,6 +325,12 @@ main(int argc, char** argv)
 
   ring->reset();
 
+  test_vectors();
+  test_move();
+  test_consume();
+  test_stats();
+  test_policies();
+
   std::thread reader_thread(reader, std::ref(ctx));
   std::thread writer_thread(writer, std::ref(ctx));
 
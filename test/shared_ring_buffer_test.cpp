@@ -0,0 +1,195 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/SharedRingBuffer.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+using SharedRingBuffer = raul::SharedRingBuffer;
+
+constexpr uint32_t n_msgs = 1U << 16U;
+
+std::string
+ring_name(const char* suffix)
+{
+  return "/raul-test-" + std::to_string(getpid()) + "-" + suffix;
+}
+
+void
+test_attach()
+{
+  // Attaching to something that doesn't exist fails
+  bool caught = false;
+  try {
+    const SharedRingBuffer missing{ring_name("missing")};
+  } catch (const std::runtime_error&) {
+    caught = true;
+  }
+  assert(caught);
+
+  // Create a ring and attach to it again (as another process would)
+  SharedRingBuffer writer{ring_name("attach"), 60U};
+  SharedRingBuffer reader{writer.name()};
+  assert(writer.capacity() == 64U);
+  assert(reader.capacity() == 64U);
+  assert(writer.write_space() == 64U);
+  assert(reader.read_space() == 0U);
+
+  // Write through one mapping and read through the other, around the end
+  char buf[8] = {};
+  for (uint32_t i = 0U; i < 20U; ++i) {
+    assert(writer.write(5U, "hello") == 5U);
+    assert(reader.read_space() == 5U);
+    assert(reader.read(sizeof(buf), buf) == 0U);
+    assert(reader.peek(5U, buf) == 5U);
+    assert(reader.read(5U, buf) == 5U);
+    assert(!strncmp(buf, "hello", 5U));
+  }
+
+  // Zero-copy vectors work across mappings too
+  const SharedRingBuffer::WriteVector wvec = writer.write_vector();
+  assert(wvec.size() == 64U);
+  wvec.first.data[0] = 'X';
+  writer.commit_write(1U);
+
+  const SharedRingBuffer::ReadVector rvec = reader.read_vector();
+  assert(rvec.size() == 1U);
+  assert(rvec.first.data[0] == 'X');
+  reader.commit_read(1U);
+  assert(writer.write_space() == 64U);
+}
+
+/// Map a shared memory object to scribble on it like a broken process
+uint32_t*
+map_raw(const std::string& name, size_t size)
+{
+  const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+  assert(fd >= 0);
+  assert(!ftruncate(fd, static_cast<off_t>(size)));
+
+  void* const mem =
+    mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  close(fd);
+  assert(mem != MAP_FAILED);
+  return static_cast<uint32_t*>(mem);
+}
+
+void
+test_corrupt()
+{
+  // The header is 3 cache lines: the magic number and size, then the heads
+  constexpr size_t   header_size = 3U * 64U;
+  constexpr uint32_t magic       = 0x52415552U;
+  constexpr size_t   write_index = 64U / sizeof(uint32_t);
+  constexpr size_t   read_index  = 128U / sizeof(uint32_t);
+
+  // Attaching to a ring with an invalid size fails
+  const std::string name = ring_name("corrupt");
+  for (const uint32_t size : {0U, 60U, 128U}) {
+    uint32_t* const raw = map_raw(name, header_size + 64U);
+    raw[0]              = magic;
+    raw[1]              = size;
+    munmap(raw, header_size + 64U);
+
+    bool caught = false;
+    try {
+      const SharedRingBuffer ring{name};
+    } catch (const std::runtime_error&) {
+      caught = true;
+    }
+    assert(caught);
+  }
+
+  shm_unlink(name.c_str());
+
+  // Heads that are too far apart make the ring look full and empty
+  SharedRingBuffer writer{ring_name("heads"), 64U};
+  SharedRingBuffer reader{writer.name()};
+  assert(writer.write(4U, "data") == 4U);
+
+  uint32_t* const raw = map_raw(writer.name(), header_size + 64U);
+  raw[read_index]     = raw[write_index] + 1U;
+
+  char buf[4] = {};
+  assert(!reader.read_space());
+  assert(!reader.read_vector().size());
+  assert(!reader.read(1U, buf));
+  assert(!writer.write_space());
+  assert(!writer.write_vector().size());
+  assert(!writer.write(1U, buf));
+
+  raw[write_index] = raw[read_index] + 1000U;
+  assert(!reader.read_space());
+  assert(!reader.read_vector().size());
+  assert(!reader.read(1U, buf));
+  assert(!writer.write_space());
+  assert(!writer.write_vector().size());
+  assert(!writer.write(1U, buf));
+
+  munmap(raw, header_size + 64U);
+}
+
+void
+test_fork()
+{
+  SharedRingBuffer ring{ring_name("fork"), 1024U};
+
+  const pid_t pid = fork();
+  assert(pid >= 0);
+  if (pid == 0) {
+    // In child, attach to the ring and write messages to the parent
+    SharedRingBuffer child_ring{ring.name()};
+    for (uint32_t i = 0U; i < n_msgs;) {
+      if (child_ring.write(sizeof(i), &i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    _exit(0);
+  }
+
+  // In parent, read all the messages from the child
+  for (uint32_t i = 0U; i < n_msgs;) {
+    uint32_t msg = 0U;
+    if (ring.read(sizeof(msg), &msg)) {
+      assert(msg == i);
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  int status = 0;
+  assert(waitpid(pid, &status, 0) == pid);
+  assert(WIFEXITED(status) && !WEXITSTATUS(status));
+  assert(ring.read_space() == 0U);
+}
+
+} // namespace
+
+int
+main()
+{
+  test_attach();
+  test_corrupt();
+  test_fork();
+  return 0;
+}
@@ -0,0 +1,138 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/SpscQueue.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace {
+
+constexpr size_t n_msgs = 1U << 16U;
+
+std::atomic<size_t> n_live_commands{0U};
+
+class Command
+{
+public:
+  explicit Command(size_t id = 0U)
+    : _id{std::make_unique<size_t>(id)}
+  {
+    ++n_live_commands;
+  }
+
+  Command(const Command&)            = delete;
+  Command& operator=(const Command&) = delete;
+
+  Command(Command&& command) noexcept
+    : _id{std::move(command._id)}
+  {
+    ++n_live_commands;
+  }
+
+  Command& operator=(Command&&) = default;
+
+  ~Command() { --n_live_commands; }
+
+  [[nodiscard]] size_t id() const { return *_id; }
+
+private:
+  std::unique_ptr<size_t> _id;
+};
+
+void
+test_single_threaded()
+{
+  {
+    raul::SpscQueue<Command, 4U> queue;
+    static_assert(raul::SpscQueue<Command, 4U>::capacity() == 4U);
+    assert(queue.empty());
+    assert(!queue.front());
+
+    Command command{};
+    assert(!queue.try_pop(command));
+
+    // Push until full, which uses the full capacity
+    assert(queue.try_push(Command{1U}));
+    assert(queue.try_emplace(2U));
+    assert(queue.try_emplace(3U));
+    assert(queue.try_emplace(4U));
+    assert(!queue.try_emplace(5U));
+    assert(queue.size() == 4U);
+    assert(n_live_commands == 5U);
+
+    // Pop in order
+    assert(queue.try_pop(command));
+    assert(command.id() == 1U);
+    assert(queue.front()->id() == 2U);
+    queue.pop();
+    assert(queue.size() == 2U);
+    assert(n_live_commands == 3U);
+
+    // Push and pop across the end
+    for (size_t i = 5U; i < 12U; ++i) {
+      assert(queue.try_emplace(i));
+      assert(queue.try_pop(command));
+      assert(command.id() == i - 2U);
+    }
+  }
+
+  // Remaining elements are destroyed with the queue
+  assert(n_live_commands == 0U);
+}
+
+void
+writer(raul::SpscQueue<Command, 64U>& queue)
+{
+  for (size_t i = 0U; i < n_msgs;) {
+    if (queue.try_emplace(i)) {
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+reader(raul::SpscQueue<Command, 64U>& queue)
+{
+  Command command{};
+  for (size_t i = 0U; i < n_msgs;) {
+    if (queue.try_pop(command)) {
+      assert(command.id() == i);
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+test_threaded()
+{
+  auto queue = std::make_unique<raul::SpscQueue<Command, 64U>>();
+
+  std::thread reader_thread(reader, std::ref(*queue));
+  std::thread writer_thread(writer, std::ref(*queue));
+
+  reader_thread.join();
+  writer_thread.join();
+
+  assert(queue->empty());
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_threaded();
+  return 0;
+}
@@ -0,0 +1,132 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#undef NDEBUG
+
+#include <raul/WaitableRingBuffer.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace {
+
+using WaitableRingBuffer = raul::WaitableRingBuffer;
+
+constexpr uint32_t n_msgs   = 1U << 14U;
+constexpr uint32_t msg_size = 100U;
+
+void
+test_single_threaded()
+{
+  WaitableRingBuffer ring{64U};
+  assert(ring.capacity() == 63U);
+
+  // Waiting times out when there's no data
+  const auto start = std::chrono::steady_clock::now();
+  assert(!ring.wait_read_space(1U, std::chrono::milliseconds(10)));
+  assert(std::chrono::steady_clock::now() - start >=
+         std::chrono::milliseconds(10));
+
+  // Waiting for more than the capacity fails immediately
+  assert(!ring.wait_read_space(64U));
+  assert(!ring.wait_read_space(64U, std::chrono::seconds(10)));
+
+  // Waiting returns immediately when there's enough data
+  assert(ring.write(4U, "abcd") == 4U);
+  assert(ring.wait_read_space(4U));
+  assert(ring.wait_read_space(4U, std::chrono::seconds(10)));
+  assert(!ring.wait_read_space(5U, std::chrono::milliseconds(1)));
+
+  char buf[4] = {};
+  assert(ring.read(4U, buf) == 4U);
+  assert(!strncmp(buf, "abcd", 4U));
+
+  // Zero-copy writes work too
+  const WaitableRingBuffer::WriteVector vec = ring.write_vector();
+  memcpy(vec.first.data, "efgh", 4U);
+  ring.commit_write(4U);
+  assert(ring.wait_read_space(4U, std::chrono::seconds(10)));
+  assert(ring.read(4U, buf) == 4U);
+  assert(!strncmp(buf, "efgh", 4U));
+}
+
+void
+test_wakeup()
+{
+  WaitableRingBuffer ring{64U};
+
+  std::thread writer_thread([&ring] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ring.write(4U, "abcd");
+  });
+
+  // Only returns early if the writer wakes us up
+  const auto start = std::chrono::steady_clock::now();
+  assert(ring.wait_read_space(4U, std::chrono::seconds(60)));
+  assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(60));
+  writer_thread.join();
+
+  writer_thread = std::thread([&ring] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ring.write(4U, "efgh");
+  });
+
+  assert(ring.wait_read_space(8U));
+  writer_thread.join();
+}
+
+void
+writer(WaitableRingBuffer& ring)
+{
+  uint8_t msg[msg_size] = {};
+  for (uint32_t i = 0U; i < n_msgs;) {
+    memset(msg, static_cast<int>(i & 0xFFU), sizeof(msg));
+    if (ring.write(sizeof(msg), msg)) {
+      ++i;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+reader(WaitableRingBuffer& ring)
+{
+  uint8_t msg[msg_size] = {};
+  for (uint32_t i = 0U; i < n_msgs; ++i) {
+    assert(ring.wait_read_space(msg_size));
+    assert(ring.read(sizeof(msg), msg) == msg_size);
+    for (uint32_t j = 0U; j < msg_size; ++j) {
+      assert(msg[j] == (i & 0xFFU));
+    }
+  }
+}
+
+void
+test_threaded()
+{
+  WaitableRingBuffer ring{1024U};
+
+  std::thread reader_thread(reader, std::ref(ring));
+  std::thread writer_thread(writer, std::ref(ring));
+
+  reader_thread.join();
+  writer_thread.join();
+
+  assert(ring.read_space() == 0U);
+}
+
+} // namespace
+
+int
+main()
+{
+  test_single_threaded();
+  test_wakeup();
+  test_threaded();
+  return 0;
+}